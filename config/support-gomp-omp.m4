@@ -29,8 +29,22 @@ AC_DEFINE_UNQUOTED([ROSE_INSTALLATION_PATH],"$prefix",[Location (unquoted) of th
 
 AC_SUBST(gomp_omp_runtime_library_path)
 
+# The native XOMP runtime (xomp_native.c) needs neither GOMP nor Omni
+AC_ARG_ENABLE(native-xomp,
+[  --enable-native-xomp	Use the native XOMP OpenMP runtime library (pthreads only) as the target of the OpenMP Translator],
+,
+enable_native_xomp=no
+)
+
+if test "x$enable_native_xomp" = xyes; then
+   echo "Setup the native XOMP OpenMP runtime library in ROSE!"
+   AC_DEFINE([USE_ROSE_NATIVE_OPENMP_LIBRARY],1,[Controls use of ROSE support for OpenMP Translator targeting the native XOMP RTL.])
+fi
+
 # End macro ROSE_WITH_GOMP_OPENMP_LIBRARY.
 AM_CONDITIONAL(WITH_GOMP_OPENMP_LIB,test ! "$with_gomp_omp_runtime_library" = no)
+AM_CONDITIONAL(WITH_NATIVE_XOMP_LIB,test "x$enable_native_xomp" = xyes)
+AM_CONDITIONAL(WITH_XOMP_RUNTIME,test ! "$with_gomp_omp_runtime_library" = no || test "x$enable_native_xomp" = xyes)
 
 ]
 )
@@ -35,7 +35,7 @@ struct Switches {
     bool save_callgraph;
     bool save_consumed_inputs;
     PolicyParams params;                                // parameters controlling instruction semantics
-    size_t nprocs;                                      // number of parallel processes to fork
+    size_t nprocs;                                      // number of parallel processes to fork or threads to run
     std::vector<std::string> signature_components;      /**< How should the signature vectors be computed */
     PathSyntactic path_syntactic;                       /**< How to compute path sensistive syntactic signature */
 };
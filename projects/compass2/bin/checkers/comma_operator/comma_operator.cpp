@@ -86,43 +86,30 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::commaOperatorChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::CommaOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_comma;
-      MatchResult results_comma = match_comma.performMatching("$r = SgCommaOpExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, results_comma)
-	{
-	  SgCommaOpExp* op = (SgCommaOpExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::CommaOperator::CheckerOutput(op));
-	}
-      
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgCommaOpExp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      output->addOutput(new CompassAnalyses::CommaOperator::CheckerOutput(node));
   }
 
 extern const Compass::Checker* const commaOperatorChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::CommaOperator::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::CommaOperator::short_description,
       CompassAnalyses::CommaOperator::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgCommaOpExp),
+      visit);
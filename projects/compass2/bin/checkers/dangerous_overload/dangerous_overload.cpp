@@ -86,46 +86,35 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dangerousOverloadChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DangerousOverload::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_member;
-      MatchResult func_matches = match_member.performMatching("$r = SgMemberFunctionDeclaration", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_matches)
-        {
-          SgMemberFunctionDeclaration* decl = (SgMemberFunctionDeclaration*)match["$r"];
-          string name = decl->get_name().getString();
-          if (name == "operator&" || name == "operator&&" || name == "operator||" || name == "operator,")
-            {
-              output->addOutput(new CompassAnalyses::DangerousOverload::CheckerOutput(decl));
-            }
-        }
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgMemberFunctionDeclaration in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgMemberFunctionDeclaration* decl = isSgMemberFunctionDeclaration(node);
+      string name = decl->get_name().getString();
+      if (name == "operator&" || name == "operator&&" || name == "operator||" || name == "operator,")
+        {
+          output->addOutput(new CompassAnalyses::DangerousOverload::CheckerOutput(decl));
+        }
   }
 
 extern const Compass::Checker* const dangerousOverloadChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::DangerousOverload::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::DangerousOverload::short_description,
       CompassAnalyses::DangerousOverload::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgMemberFunctionDeclaration),
+      visit);
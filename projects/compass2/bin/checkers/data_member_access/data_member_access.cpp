@@ -86,63 +86,52 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dataMemberAccessChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DataMemberAccess::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_classes;
-      MatchResult result_classes = match_classes.performMatching("$r = SgClassDefinition", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_classes)
-	{
-	  SgClassDefinition* classdef = (SgClassDefinition*)match["$r"];
-	  int pub, prot, priv;
-	  pub = prot = priv = 0;
-	  SgDeclarationStatementPtrList members = classdef->get_members();
-	  SgDeclarationStatementPtrList::iterator member;
-	  for (member = members.begin(); member != members.end(); ++member)
-	    {
-	      SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
-	      if (vardecl != NULL)
-		{
-		  SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
-		  if (mod.isPublic())
-		    ++pub;
-		  else if (mod.isProtected())
-		    ++prot;
-		  else if (mod.isPrivate())
-		    ++priv;
-		}
-	    }
-	  if (pub != 0 && prot + priv != 0)
-	    {
-	      output->addOutput(new CompassAnalyses::DataMemberAccess::CheckerOutput(classdef));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgClassDefinition in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgClassDefinition* classdef = isSgClassDefinition(node);
+      int pub, prot, priv;
+      pub = prot = priv = 0;
+      const SgDeclarationStatementPtrList& members = classdef->get_members();
+      SgDeclarationStatementPtrList::const_iterator member;
+      for (member = members.begin(); member != members.end(); ++member)
+        {
+          SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
+          if (vardecl != NULL)
+            {
+              SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
+              if (mod.isPublic())
+                ++pub;
+              else if (mod.isProtected())
+                ++prot;
+              else if (mod.isPrivate())
+                ++priv;
+            }
+        }
+      if (pub != 0 && prot + priv != 0)
+        {
+          output->addOutput(new CompassAnalyses::DataMemberAccess::CheckerOutput(classdef));
+        }
   }
 
 extern const Compass::Checker* const dataMemberAccessChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::DataMemberAccess::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::DataMemberAccess::short_description,
       CompassAnalyses::DataMemberAccess::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgClassDefinition),
+      visit);
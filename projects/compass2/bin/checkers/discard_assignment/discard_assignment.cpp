@@ -86,45 +86,33 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::discardAssignmentChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DiscardAssignment::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_assign;
-      MatchResult result_assign = match_assign.performMatching("$r = SgAssignOp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_assign)
-	{
-	  SgAssignOp* op = (SgAssignOp*)match["$r"];
-	  if (!isSgExprStatement(op->get_parent()))
-	    {
-	      output->addOutput(new CompassAnalyses::DiscardAssignment::CheckerOutput(op));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgAssignOp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      if (!isSgExprStatement(node->get_parent()))
+        {
+          output->addOutput(new CompassAnalyses::DiscardAssignment::CheckerOutput(node));
+        }
   }
 
 extern const Compass::Checker* const discardAssignmentChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::DiscardAssignment::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::DiscardAssignment::short_description,
       CompassAnalyses::DiscardAssignment::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgAssignOp),
+      visit);
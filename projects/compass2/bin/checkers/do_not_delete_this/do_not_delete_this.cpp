@@ -86,42 +86,34 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::doNotDeleteThisChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DoNotDeleteThis::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_del_this;
-      MatchResult result_del_this = match_del_this.performMatching("$r = SgDeleteExp(SgThisExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_del_this)
-	{
-	  SgDeleteExp* del = (SgDeleteExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::DoNotDeleteThis::CheckerOutput(del));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgDeleteExp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgDeleteExp* del = isSgDeleteExp(node);
+      if (isSgThisExp(del->get_variable()))
+        {
+          output->addOutput(new CompassAnalyses::DoNotDeleteThis::CheckerOutput(del));
+        }
   }
 
 extern const Compass::Checker* const doNotDeleteThisChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::DoNotDeleteThis::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::DoNotDeleteThis::short_description,
       CompassAnalyses::DoNotDeleteThis::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgDeleteExp),
+      visit);
@@ -83,43 +83,30 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                        ::noGotoChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoGoto::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-
-
-  // search for SgGotoStatements
-  AstMatching matcher;
-  MatchResult matches = matcher
-      .performMatching("$r = SgGotoStatement", root_node);
-
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+initialize(Compass::Parameters parameters)
   {
-    SgGotoStatement *goto_statement = (SgGotoStatement *)match["$r"];
-    output->addOutput(
-        new CompassAnalyses::NoGoto::
-        CheckerOutput(goto_statement));
+      // We only care about source code in the user's space, not,
+      // for example, Boost or system files.
+      string target_directory =
+          parameters["general::target_directory"].front();
+      CompassAnalyses::NoGoto::source_directory.assign(target_directory);
   }
 
-}
+// Called for each SgGotoStatement in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
+  {
+      output->addOutput(new CompassAnalyses::NoGoto::CheckerOutput(node));
+  }
 
 extern const Compass::Checker* const noGotoChecker =
-    new Compass::CheckerUsingAstSimpleProcessing(
-        CompassAnalyses::NoGoto::checker_name,
-        // Descriptions should not include the newline character "\n".
-        CompassAnalyses::NoGoto::short_description,
-        CompassAnalyses::NoGoto::long_description,
-        Compass::C | Compass::Cpp,
-        Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-        run,
-        NULL);
-
+  new Compass::CheckerUsingNodeVisits(
+      CompassAnalyses::NoGoto::checker_name,
+    // Descriptions should not include the newline character "\n".
+      CompassAnalyses::NoGoto::short_description,
+      CompassAnalyses::NoGoto::long_description,
+      Compass::C | Compass::Cpp,
+      Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
+      initialize,
+      std::vector<VariantT>(1, V_SgGotoStatement),
+      visit);
@@ -84,46 +84,35 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                        ::noRandChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoRand::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-  // perform AST matching
-  AstMatching matcher;
-
-  MatchResult matches = matcher.performMatching("$r=SgFunctionRefExp",
-                                                root_node);
-
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+initialize(Compass::Parameters parameters)
   {
-    SgFunctionRefExp *function = (SgFunctionRefExp *)match["$r"];
-    std::string fncName = function->get_symbol()->get_name().getString();
-
-    if( fncName.find( "rand", 0, 4) != std::string::npos)
-    {
-      output->addOutput(
-          new CompassAnalyses::NoRand::CheckerOutput(function));
-    }
+      // We only care about source code in the user's space, not,
+      // for example, Boost or system files.
+      string target_directory =
+          parameters["general::target_directory"].front();
+      CompassAnalyses::NoRand::source_directory.assign(target_directory);
   }
-}
 
+// Called for each SgFunctionRefExp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
+  {
+      SgFunctionRefExp* function = isSgFunctionRefExp(node);
+      std::string fncName = function->get_symbol()->get_name().getString();
+      if (fncName.find("rand", 0, 4) != std::string::npos)
+        {
+          output->addOutput(new CompassAnalyses::NoRand::CheckerOutput(function));
+        }
+  }
 
 extern const Compass::Checker* const noRandChecker =
-    new Compass::CheckerUsingAstSimpleProcessing(
-        CompassAnalyses::NoRand::checker_name,
-        // Descriptions should not include the newline character "\n".
-        CompassAnalyses::NoRand::short_description,
-        CompassAnalyses::NoRand::long_description,
-        Compass::C | Compass::Cpp,
-        Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-        run,
-        NULL);
-
+  new Compass::CheckerUsingNodeVisits(
+      CompassAnalyses::NoRand::checker_name,
+    // Descriptions should not include the newline character "\n".
+      CompassAnalyses::NoRand::short_description,
+      CompassAnalyses::NoRand::long_description,
+      Compass::C | Compass::Cpp,
+      Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
+      initialize,
+      std::vector<VariantT>(1, V_SgFunctionRefExp),
+      visit);
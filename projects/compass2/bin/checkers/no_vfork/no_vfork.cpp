@@ -89,51 +89,35 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::noVforkChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::NoVfork::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      SgNode *root_node = (SgNode*)sageProject;
-
-      AstMatching func_ref_matcher;
-      MatchResult func_ref_matches = func_ref_matcher
-          .performMatching("$f=SgFunctionRefExp", root_node);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_ref_matches)
-      {
-        SgFunctionRefExp *func_ref = (SgFunctionRefExp *)match["$f"];
-        std::string func_str = func_ref->get_symbol()->get_name().getString();
-        if(func_str.compare("vfork") == 0)
-        {
-          output->addOutput(
-              new CompassAnalyses::NoVfork::
-              CheckerOutput(func_ref));
-        }
-      }
-      
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgFunctionRefExp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgFunctionRefExp* func_ref = isSgFunctionRefExp(node);
+      std::string func_str = func_ref->get_symbol()->get_name().getString();
+      if (func_str.compare("vfork") == 0)
+        {
+          output->addOutput(new CompassAnalyses::NoVfork::CheckerOutput(func_ref));
+        }
   }
 
 extern const Compass::Checker* const noVforkChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::NoVfork::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::NoVfork::short_description,
       CompassAnalyses::NoVfork::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgFunctionRefExp),
+      visit);
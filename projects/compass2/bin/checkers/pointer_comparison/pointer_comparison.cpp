@@ -86,53 +86,45 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::pointerComparisonChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::PointerComparison::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching matchop;
-      MatchResult result = matchop.performMatching
-	("$r = SgGreaterThanOp\
-        | $r = SgGreaterOrEqualOp\
-        | $r = SgLessThanOp\
-        | $r = SgLessOrEqualOp"
-	, sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result)
-	{
-	  SgBinaryOp* op = (SgBinaryOp*)match["$r"];
-	  SgType *lhs, *rhs;
-	  lhs = op->get_lhs_operand()->get_type();
-	  rhs = op->get_rhs_operand()->get_type();
-	  if (isSgPointerType(lhs) || isSgPointerType(rhs))
-	    {
-	      output->addOutput(new CompassAnalyses::PointerComparison::CheckerOutput(op));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgGreaterThanOp, SgGreaterOrEqualOp, SgLessThanOp and SgLessOrEqualOp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgBinaryOp* op = isSgBinaryOp(node);
+      SgType *lhs, *rhs;
+      lhs = op->get_lhs_operand()->get_type();
+      rhs = op->get_rhs_operand()->get_type();
+      if (isSgPointerType(lhs) || isSgPointerType(rhs))
+        {
+          output->addOutput(new CompassAnalyses::PointerComparison::CheckerOutput(op));
+        }
   }
 
+static const VariantT variants[] =
+  {
+    V_SgGreaterThanOp,
+    V_SgGreaterOrEqualOp,
+    V_SgLessThanOp,
+    V_SgLessOrEqualOp
+  };
+
 extern const Compass::Checker* const pointerComparisonChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::PointerComparison::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::PointerComparison::short_description,
       CompassAnalyses::PointerComparison::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(variants, variants + sizeof variants / sizeof variants[0]),
+      visit);
@@ -86,43 +86,34 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::sizeOfPointerChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::SizeOfPointer::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_sizeof;
-      MatchResult result_sizeof = match_sizeof.performMatching("SgSizeOfOp($r=SgVarRefExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_sizeof)
-	{
-	  SgVarRefExp* var_ref = (SgVarRefExp*)match["$r"];
-	  if(isSgPointerType(var_ref->get_type()))
-	    output->addOutput(new CompassAnalyses::SizeOfPointer::CheckerOutput(var_ref));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgSizeOfOp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      SgVarRefExp* var_ref = isSgVarRefExp(isSgSizeOfOp(node)->get_operand_expr());
+      if (var_ref != NULL && isSgPointerType(var_ref->get_type()))
+        {
+          output->addOutput(new CompassAnalyses::SizeOfPointer::CheckerOutput(var_ref));
+        }
   }
 
 extern const Compass::Checker* const sizeOfPointerChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::SizeOfPointer::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::SizeOfPointer::short_description,
       CompassAnalyses::SizeOfPointer::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgSizeOfOp),
+      visit);
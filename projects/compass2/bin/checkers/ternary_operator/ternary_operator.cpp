@@ -86,42 +86,30 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::ternaryOperatorChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::TernaryOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_ternary;
-      MatchResult result_ternary = match_ternary.performMatching("$r = SgConditionalExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_ternary)
-	{
-	  SgConditionalExp* tri = (SgConditionalExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::TernaryOperator::CheckerOutput(tri));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgConditionalExp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      output->addOutput(new CompassAnalyses::TernaryOperator::CheckerOutput(node));
   }
 
 extern const Compass::Checker* const ternaryOperatorChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::TernaryOperator::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::TernaryOperator::short_description,
       CompassAnalyses::TernaryOperator::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgConditionalExp),
+      visit);
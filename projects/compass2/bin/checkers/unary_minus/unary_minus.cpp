@@ -86,48 +86,38 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::unaryMinusChecker->shortDescription) {}
 
 static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+initialize(Compass::Parameters parameters)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::UnaryMinus::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_var;
-      MatchResult result_var = match_var.performMatching
-	("SgMinusOp($r=SgVarRefExp)\
-        | SgMinusOp(SgCastExp($r=SgVarRefExp))"\
-        , sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_var)
-	{
-	  SgVarRefExp* var = (SgVarRefExp*)match["$r"];
-	  if (var->get_type()->isUnsignedType())
-	    {
-	      output->addOutput(new CompassAnalyses::UnaryMinus::CheckerOutput(var));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
-static Compass::AstSimpleProcessingWithRunFunction*
-createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+// Called for each SgMinusOp in the project
+static void
+visit(SgNode* node, Compass::OutputObject* output)
   {
-    return NULL;
+      // Matches -x and -(T)x
+      SgExpression* operand = isSgMinusOp(node)->get_operand();
+      if (SgCastExp* cast = isSgCastExp(operand))
+        operand = cast->get_operand();
+      SgVarRefExp* var = isSgVarRefExp(operand);
+      if (var != NULL && var->get_type()->isUnsignedType())
+        {
+          output->addOutput(new CompassAnalyses::UnaryMinus::CheckerOutput(var));
+        }
   }
 
 extern const Compass::Checker* const unaryMinusChecker =
-  new Compass::CheckerUsingAstSimpleProcessing(
+  new Compass::CheckerUsingNodeVisits(
       CompassAnalyses::UnaryMinus::checker_name,
     // Descriptions should not include the newline character "\n".
       CompassAnalyses::UnaryMinus::short_description,
       CompassAnalyses::UnaryMinus::long_description,
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
-      run,
-      createTraversal);
-
+      initialize,
+      std::vector<VariantT>(1, V_SgMinusOp),
+      visit);
@@ -234,10 +234,48 @@ int main (int argc, char** argv)
     //  Run Compass Analyses
     // -------------------------------------------------------------------------
 
-    std::vector<std::pair<std::string, std::string> > errors;
+    // Checkers that only visit nodes of some variants share one traversal
+    // of the AST; the others each run on their own below.
+    std::vector<const Compass::CheckerUsingNodeVisits*> node_visit_checkers;
+    std::vector<const Compass::Checker*> other_checkers;
     for (std::vector<const Compass::Checker*>::iterator itr = traversals.begin();
          itr != traversals.end();
          ++itr)
+    {
+        const Compass::CheckerUsingNodeVisits* node_visit_checker =
+            dynamic_cast<const Compass::CheckerUsingNodeVisits*> (*itr);
+        if (node_visit_checker != NULL)
+            node_visit_checkers.push_back (node_visit_checker);
+        else
+            other_checkers.push_back (*itr);
+    }
+
+    std::vector<std::pair<std::string, std::string> > errors;
+    if (!node_visit_checkers.empty ())
+    {
+        if (SgProject::get_verbose () >= 0)
+        {
+            std::cout
+              << "[Compass] [Main] "
+              << "Running "
+              << node_visit_checkers.size ()
+              << " checkers in one traversal:";
+            for (size_t i = 0; i < node_visit_checkers.size (); ++i)
+                std::cout << " " << node_visit_checkers[i]->checkerName;
+            std::cout << std::endl;
+        }
+
+        // ---------------------------------------------------------------------
+        //  !! PERFORM TRAVERSAL !!
+        // ---------------------------------------------------------------------
+        std::vector<std::pair<std::string, std::string> > node_visit_errors =
+            Compass::runCheckersInOneTraversal (node_visit_checkers, project, params, &output);
+        errors.insert (errors.end (), node_visit_errors.begin (), node_visit_errors.end ());
+    }
+
+    for (std::vector<const Compass::Checker*>::iterator itr = other_checkers.begin();
+         itr != other_checkers.end();
+         ++itr)
     {
         if (*itr == NULL)
         {
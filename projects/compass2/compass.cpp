@@ -19,6 +19,7 @@
  **--------------------------------------------------------------------------*/
 // Boost C++ libraries
 #include "boost/filesystem/operations.hpp"
+#include <boost/bind.hpp>
 
 /*-----------------------------------------------------------------------------
  * Project includes
@@ -311,6 +312,120 @@ void Compass::runCheckerAndPrereqs(const Checker* checker, SgProject* proj, Para
   checker->run(params, output);
 }
 
+namespace {
+
+// Calls the visit functions of the checkers interested in each node's variant.
+class NodeVisitDispatcher: public AstSimpleProcessing {
+public:
+  typedef std::vector<std::pair<std::string, std::string> > ErrorList;
+
+  NodeVisitDispatcher(const std::vector<const CheckerUsingNodeVisits*>& checkers, ErrorList& errors)
+    : checkers(checkers), buffers(checkers.size()), failed(checkers.size(), false), byVariant(V_SgNumVariants),
+      errors(errors) {
+    for (size_t i = 0; i < checkers.size(); ++i) {
+      const std::vector<VariantT>& variants = checkers[i]->variants;
+      for (size_t j = 0; j < variants.size(); ++j) {
+        ROSE_ASSERT(variants[j] < V_SgNumVariants);
+        byVariant[variants[j]].push_back(i);
+      }
+    }
+  }
+
+  // Passes the messages of each checker on to the output, checker by checker.
+  void flush(OutputObject* output) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      std::vector<OutputViolationBase*> messages = buffers[i].getOutputList();
+      for (size_t j = 0; j < messages.size(); ++j)
+        output->addOutput(messages[j]);
+      buffers[i].clear();
+    }
+  }
+
+protected:
+  void visit(SgNode* node) {
+    const std::vector<size_t>& interested = byVariant[node->variantT()];
+    for (size_t k = 0; k < interested.size(); ++k) {
+      size_t i = interested[k];
+      if (failed[i])
+        continue;
+      try {
+        checkers[i]->visit(node, &buffers[i]);
+      } catch (const std::exception& e) {
+        failed[i] = true;
+        errors.push_back(std::make_pair(checkers[i]->checkerName, std::string(e.what())));
+      }
+    }
+  }
+
+private:
+  const std::vector<const CheckerUsingNodeVisits*>& checkers;
+  std::vector<BufferingOutputObject> buffers;
+  std::vector<bool> failed;
+  std::vector<std::vector<size_t> > byVariant;                // checker indices by VariantT
+  ErrorList& errors;
+};
+
+void
+runNodeVisitChecker(const CheckerUsingNodeVisits* checker, Parameters params, OutputObject* output) {
+  std::vector<std::pair<std::string, std::string> > errors =
+    runCheckersInOneTraversal(std::vector<const CheckerUsingNodeVisits*>(1, checker),
+                              projectPrerequisite.getProject(), params, output);
+  if (!errors.empty())
+    throw std::runtime_error(errors.front().second);
+}
+
+} // namespace
+
+Compass::CheckerUsingNodeVisits::CheckerUsingNodeVisits(
+    std::string checkerName,
+    std::string shortDescription,
+    std::string longDescription,
+    LanguageSet supportedLanguages,
+    const PrerequisiteList& prerequisites,
+    InitializeFunction initialize,
+    const std::vector<VariantT>& variants,
+    VisitFunction visit)
+  : Checker (checkerName,
+             shortDescription,
+             longDescription,
+             supportedLanguages,
+             prerequisites,
+             RunFunction()),
+    initialize (initialize),
+    variants (variants),
+    visit (visit)
+{
+  run = boost::bind(runNodeVisitChecker, this, _1, _2);
+}
+
+std::vector<std::pair<std::string, std::string> >
+Compass::runCheckersInOneTraversal(const std::vector<const CheckerUsingNodeVisits*>& checkers, SgProject* proj,
+                                   Parameters params, OutputObject* output) {
+  ROSE_ASSERT(proj != NULL);
+  ROSE_ASSERT(output != NULL);
+  std::vector<std::pair<std::string, std::string> > errors;
+  std::vector<const CheckerUsingNodeVisits*> initialized;
+  for (size_t i = 0; i < checkers.size(); ++i) {
+    ROSE_ASSERT(checkers[i] != NULL);
+    try {
+      if (checkers[i]->initialize)
+        checkers[i]->initialize(params);
+      initialized.push_back(checkers[i]);
+    } catch (const std::exception& e) {
+      errors.push_back(std::make_pair(checkers[i]->checkerName, std::string(e.what())));
+    }
+  }
+
+  // The files are not sharded across threads. Checkers call get_type() on
+  // expressions (e.g. pointerComparison), which can build a type and insert
+  // it into the unlocked global type table. A checker's visit function may
+  // also keep state of its own between calls.
+  NodeVisitDispatcher dispatcher(initialized, errors);
+  dispatcher.traverse(proj, preorder);
+  dispatcher.flush(output);
+  return errors;
+}
+
 namespace Compass
 {
 
@@ -757,6 +757,19 @@ namespace Xml
         std::ostream& stream;
     };// end PrintingOutputObject class
 
+  /** An output object which only keeps the error messages, so that they can
+    * be passed on to another output object later (see
+    * runCheckersInOneTraversal()).
+    */
+  class BufferingOutputObject: public OutputObject
+    {
+      public:
+        virtual void addOutput (OutputViolationBase* theOutput)
+          {
+            outputList.push_back(theOutput);
+          }
+    };// end BufferingOutputObject class
+
   /** \brief Format file info according to the GNU standard.
     *
     * See http://www.gnu.org/prep/standards/html_node/Errors.html
@@ -1045,6 +1058,57 @@ namespace Xml
    * @}
    **------------------------------------------------------------------*/
 
+  /*--------------------------------------------------------------------
+   *
+   * Node visits
+   *
+   **------------------------------------------------------------------*/
+  /**
+   * @defgroup NodeVisits
+   * @ingroup Checkers
+   * @{
+   *//*----------------------------------------------------------------*/
+
+  /** A checker that only looks at individual IR nodes of some variants.
+    * Instead of traversing the AST itself, it lists the variants it wants to
+    * see and a function to visit them with, so that runCheckersInOneTraversal()
+    * can run any number of these checkers with a single traversal of the AST.
+    * A node is visited if its variantT() is in the list; subclasses of the
+    * listed classes are not visited unless they are listed too.
+    *
+    * The run function of the checker runs it alone with its own traversal.
+    */
+  class CheckerUsingNodeVisits: public Checker
+    {
+      public:
+        typedef boost::function<void /*initialize*/(Parameters)> InitializeFunction;
+        typedef boost::function<void /*visit*/(SgNode*, OutputObject*)> VisitFunction;
+
+        //! Called once with the parameters before any node is visited.
+        InitializeFunction initialize;
+        //! The variants of the nodes to visit.
+        std::vector<VariantT> variants;
+        //! Called for each node of one of the variants, in preorder.
+        VisitFunction visit;
+
+        CheckerUsingNodeVisits (
+            std::string checkerName,
+            std::string shortDescription,
+            std::string longDescription,
+            LanguageSet supportedLanguages,
+            const PrerequisiteList& prerequisites,
+            InitializeFunction initialize,
+            const std::vector<VariantT>& variants,
+            VisitFunction visit);
+    };// end CheckerUsingNodeVisits class
+
+  /**--------------------------------------------------------------------
+   *
+   * End of Node Visits group
+   *
+   * @}
+   **------------------------------------------------------------------*/
+
 //  #include "prerequisites.h"
 
   //! Run the prerequisites for a checker
@@ -1055,6 +1119,17 @@ namespace Xml
 
   //! Run a checker and its prerequisites
   void runCheckerAndPrereqs (const Checker* checker, SgProject* proj, Parameters params, OutputObject* output);
+
+  /** Run checkers that use node visits with one traversal of the project.
+    * The prerequisites must already have been run.  The error messages of
+    * each checker are kept until the traversal is done and then added to
+    * @p output checker by checker, in the order of @p checkers, as if the
+    * checkers had been run one after another.  A checker that throws an
+    * exception is not called again; its name and the reason are returned.
+    */
+  std::vector<std::pair<std::string, std::string> >
+  runCheckersInOneTraversal (const std::vector<const CheckerUsingNodeVisits*>& checkers, SgProject* proj,
+                             Parameters params, OutputObject* output);
   /**--------------------------------------------------------------------
    *
    * End of Checkers group
@@ -656,6 +656,9 @@
 //AS Don't know what to do with this
 #undef USE_ROSE_OMNI_OPENMP_SUPPORT
 
+/* Controls use of ROSE support for OpenMP Translator targeting the native XOMP RTL. */
+#undef USE_ROSE_NATIVE_OPENMP_LIBRARY
+
 /* Always enable Fortran support whenever Java and gfortran are present */
 //AS don't know what to do with this
 #undef USE_ROSE_OPEN_FORTRAN_PARSER_SUPPORT
@@ -3,6 +3,8 @@
 
 #include "Sawyer/Message.h"
 
+#include <map>
+
 /** Base class for loading a static or dynamic object.
  *
  *  The BinaryLoader class is the base class that defines the public interface and provides generic implementations for
@@ -292,6 +294,14 @@ public:
      *  added to the AST if Dwarf support is enable and the information is present in the binary container. */
     static SgAsmGenericFile *createAsmAST(SgBinaryComposite *composite, std::string filePath);
 
+    /** Parses several binary files concurrently ahead of createAsmAST().  The files are independent of one another, so each
+     *  is parsed by SgAsmExecutableFileFormat::parseBinaryFormat() in its own task using up to @p nThreads threads (zero
+     *  means use the hardware concurrency).  The resulting SgAsmGenericFile trees are held until createAsmAST() is called
+     *  for the same file, which then attaches the pre-parsed tree instead of parsing the file again.  A file that fails to
+     *  parse here is simply parsed again by createAsmAST(), which reports the error.  Does nothing unless ROSE is built
+     *  with thread support, since IR node allocation is locked only in that case. */
+    static void preparse(const std::vector<std::string> &filePaths, size_t nThreads);
+
     /** Finds shared object dependencies of a single binary header.  Returns a list of dependencies, which are usually library
      *  names rather than actual files.  The library names can be turned into file names by calling find_so_file().  Only one
      *  header is inspected (i.e., this function is not recursive) and no attempt is made to remove names from the return
@@ -412,6 +422,7 @@ private:
     void init();                                        /**< Further initializations in a *.C file. */
 
     static std::vector<BinaryLoader*> loaders;          /**< List of loader subclasses. */
+    static std::map<std::string, SgAsmGenericFile*> preparsed; /**< Files parsed by preparse(), by canonical name. */
     std::vector<std::string> preloads;                  /**< Libraries that should be pre-loaded. */
     std::vector<std::string> directories;               /**< Directories to search for libraries with relative names. */
 
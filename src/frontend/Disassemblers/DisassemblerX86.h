@@ -42,6 +42,65 @@ public:
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) ROSE_OVERRIDE;
 
 
+    /*========================================================================================================================
+     * Lightweight decoding
+     *========================================================================================================================*/
+public:
+    /** Control flow classification for an instruction summary. */
+    enum SummaryFlow {
+        FLOW_NONE,                                      /**< Always falls through to the next instruction. */
+        FLOW_JUMP,                                      /**< Unconditional relative jump to the summary's target. */
+        FLOW_BRANCH,                                    /**< Conditional relative branch (Jcc, JCXZ, LOOP, etc.). */
+        FLOW_CALL,                                      /**< Relative call to the summary's target. */
+        FLOW_INDIRECT_JUMP,                             /**< Indirect or far jump; target is not known. */
+        FLOW_INDIRECT_CALL,                             /**< Indirect or far call; target is not known. */
+        FLOW_RETURN,                                    /**< Near or far return, or IRET. */
+        FLOW_INTERRUPT,                                 /**< Software interrupt or system call. */
+        FLOW_HALT                                       /**< HLT or UD2. */
+    };
+
+    /** Compact description of one instruction.
+     *
+     *  This is a plain-old-data type produced by @ref summarizeInstruction without allocating any IR nodes. A size of zero
+     *  means the lightweight decoder declined the bytes (invalid, unsupported, or too rare to bother with) and the caller
+     *  should use @ref disassembleOne instead. */
+    struct InstructionSummary {
+        rose_addr_t va;                                 /**< Address of the first byte of the instruction. */
+        rose_addr_t target;                             /**< Branch target for relative jumps, branches, and calls. */
+        uint8_t size;                                   /**< Instruction length in bytes, or zero if not decoded. */
+        uint8_t flow;                                   /**< Control flow classification, a SummaryFlow constant. */
+        uint8_t opcodeMap;                              /**< 0 for the one-byte map, 1 for the two-byte 0x0f map. */
+        uint8_t opcode;                                 /**< Final opcode byte within @c opcodeMap. */
+        uint8_t modrm;                                  /**< ModR/M byte if @c hasModrm is set, otherwise zero. */
+        bool hasModrm;                                  /**< True if the instruction has a ModR/M byte. */
+        bool operandSizeOverride;                       /**< True if the 0x66 prefix is present. */
+        bool rexW;                                      /**< True if a REX prefix with the W bit is present (64-bit only). */
+
+        InstructionSummary()
+            : va(0), target(0), size(0), flow(FLOW_NONE), opcodeMap(0), opcode(0), modrm(0), hasModrm(false),
+              operandSizeOverride(false), rexW(false) {}
+    };
+
+    /** Decode the length and control flow properties of one instruction.
+     *
+     *  Uses opcode lookup tables to find the instruction boundaries without building an SgAsmX86Instruction. Returns true and
+     *  fills in @p summary if the bytes at @p buf (at most @p bufsz of them) form an instruction that the lightweight decoder
+     *  understands; otherwise returns false and sets the summary size to zero.  The lightweight decoder covers the general
+     *  purpose, x87, MMX, and common SSE opcodes. It checks encodings only as far as needed to determine lengths, so a few
+     *  operand combinations that @ref disassembleOne rejects may still be summarized. */
+    bool summarizeInstruction(rose_addr_t va, const uint8_t *buf, size_t bufsz, InstructionSummary &summary /*out*/) const;
+
+    /** Linear sweep using the lightweight decoder.
+     *
+     *  Decodes up to @p maxInsns consecutive instructions starting at @p startVa, reading memory that satisfies this
+     *  disassembler's protection requirements, and appends the summaries to @p summaries. The sweep stops early when it reaches
+     *  unmapped memory or bytes that the lightweight decoder declines; in the latter case a final summary with zero size is
+     *  appended so the caller knows where to fall back to @ref disassembleOne. Returns the number of instructions that were
+     *  decoded, not counting any zero-size summary. */
+    size_t summarizeInstructions(const MemoryMap *map, rose_addr_t startVa, size_t maxInsns,
+                                 std::vector<InstructionSummary> &summaries /*in,out*/) const;
+
+
     /*========================================================================================================================
      * Data types
      *========================================================================================================================*/
@@ -306,6 +306,19 @@ public:
     Partitioner partition(const std::string &fileName) /*final*/;
     /** @} */
 
+    /** Partition using saved results from an earlier run.
+     *
+     *  This is like @ref partition except the new partitioner is first seeded from a snapshot written by @ref
+     *  Snapshot::save.  Basic blocks and functions that lie entirely within memory whose content is unchanged since the
+     *  snapshot was taken are restored without being rediscovered; functions that touch modified bytes are attached with only
+     *  their entry address and their bodies are rediscovered by @ref runPartitioner.  This is much faster than @ref partition
+     *  when a specimen has been patched in only a few places.
+     *
+     * @{ */
+    virtual Partitioner partitionIncrementally(const std::vector<std::string> &fileNames, const FileSystem::Path &snapshot);
+    Partitioner partitionIncrementally(const std::string &fileName, const FileSystem::Path &snapshot) /*final*/;
+    /** @} */
+
     /** Obtain an abstract syntax tree.
      *
      *  Constructs a new abstract syntax tree (AST) from partitioner information with these steps:
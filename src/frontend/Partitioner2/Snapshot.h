@@ -0,0 +1,90 @@
+#ifndef ROSE_Partitioner2_Snapshot_H
+#define ROSE_Partitioner2_Snapshot_H
+
+#include <FileSystem.h>
+#include <Partitioner2/Partitioner.h>
+
+#include <iostream>
+#include <string>
+
+namespace rose {
+namespace BinaryAnalysis {
+namespace Partitioner2 {
+
+/** Saving and restoring partitioner results.
+ *
+ *  A snapshot is a compact, line-oriented text description of a partitioner's basic blocks (instruction addresses and
+ *  control flow successors), data blocks, and functions.  It also records a content hash for each chunk of each segment of
+ *  the memory map that was partitioned, where the chunks are the parts of a segment between multiples of @ref chunkSize.
+ *
+ *  When a snapshot is restored into a partitioner whose memory map has been modified (e.g., a binary patch), the chunk
+ *  hashes are compared against the new memory map, so a patch of a few bytes invalidates only the chunks that contain them
+ *  rather than the whole segment.  Basic blocks that lie entirely within unchanged chunks are
+ *  reconstructed from the saved instruction addresses and successors without running any of the partitioner's
+ *  discovery. Functions whose blocks and data all lie in unchanged segments are restored completely; functions that touch
+ *  modified bytes are attached with only their entry address so that normal partitioning rediscovers their bodies.
+ *
+ *  @code
+ *   Partitioner2::Engine engine;
+ *   Partitioner2::Partitioner p1 = engine.partition(specimen);
+ *   Partitioner2::Snapshot::save(p1, "specimen.p2snap");
+ *
+ *   // later, after patching the specimen
+ *   Partitioner2::Engine engine2;
+ *   Partitioner2::Partitioner p2 = engine2.partitionIncrementally(patchedSpecimen, "specimen.p2snap");
+ *  @endcode */
+namespace Snapshot {
+
+/** Size of the parts of memory that are hashed separately.
+ *
+ *  This is the size used by @ref save; @ref restore uses the size recorded in the snapshot. */
+static const rose_addr_t chunkSize = 4096;
+
+/** Statistics about a restore operation. */
+struct RestoreStats {
+    size_t nChunksUnchanged;                            /**< Saved chunks whose content is unchanged. */
+    size_t nChunksChanged;                              /**< Saved chunks that are modified or no longer mapped. */
+    size_t nBlocksRestored;                             /**< Basic blocks attached from the snapshot. */
+    size_t nBlocksDropped;                              /**< Basic blocks skipped because they touch modified bytes. */
+    size_t nFunctionsRestored;                          /**< Functions restored with all of their blocks. */
+    size_t nFunctionsDropped;                           /**< Functions attached with only their entry address. */
+
+    RestoreStats()
+        : nChunksUnchanged(0), nChunksChanged(0), nBlocksRestored(0), nBlocksDropped(0), nFunctionsRestored(0),
+          nFunctionsDropped(0) {}
+};
+
+/** Save partitioner results.
+ *
+ *  Writes the basic blocks, data blocks, functions, and the hashes of the memory map chunks of the partitioner to the
+ *  specified stream or file.
+ *
+ * @{ */
+void save(const Partitioner&, std::ostream&);
+void save(const Partitioner&, const FileSystem::Path&);
+/** @} */
+
+/** Restore partitioner results.
+ *
+ *  Reads a snapshot previously written by @ref save and attaches to the partitioner all the basic blocks, data blocks, and
+ *  functions that do not overlap with modified parts of the partitioner's memory map.  The partitioner should normally be
+ *  freshly created and not yet have run any discovery.  An <code>std::runtime_error</code> is thrown if the snapshot is
+ *  malformed.
+ *
+ * @{ */
+RestoreStats restore(Partitioner&, std::istream&);
+RestoreStats restore(Partitioner&, const FileSystem::Path&);
+/** @} */
+
+/** Content hash for part of a memory map.
+ *
+ *  Returns a 64-bit FNV-1a hash of the bytes mapped at the specified addresses, or nothing if some of those addresses are not
+ *  mapped. */
+Sawyer::Optional<uint64_t> hashAddresses(const MemoryMap&, const AddressInterval&);
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
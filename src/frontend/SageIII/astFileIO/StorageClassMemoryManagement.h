@@ -333,8 +333,9 @@ class EasyStorage <rose_hash_multimap*> :
      typedef StorageClassMemoryManagement <EasyStorageMapEntry<SgName,SgSymbol*> > Base;
     private:
      unsigned long parent;
+     bool case_insensitive_semantics;
     public: 
-     EasyStorage() {parent = 0;}
+     EasyStorage() {parent = 0; case_insensitive_semantics = false;}
      void storeDataInEasyStorageClass(rose_hash_multimap* data_);
      rose_hash_multimap* rebuildDataStoredInEasyStorageClass() const;
      static void arrangeMemoryPoolInOneBlock() ;
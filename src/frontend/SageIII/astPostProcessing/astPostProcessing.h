@@ -5,6 +5,9 @@
 
 #include "AstFixup.h"
 
+// Support for running post-processing passes that only need local information in one fused traversal.
+#include "postProcessingPasses.h"
+
 #include "resetParentPointers.h"
 #include "processTemplateHandlingOptions.h"
 #include "fixupSymbolTables.h"
@@ -77,7 +80,7 @@
 
 /*! \brief Postprocessing that is not likely to be handled in the EDG/Sage III translation.
  */
-void postProcessingSupport (SgNode* node);
+void postProcessingSupport (SgNode* node, size_t nThreads = 1);
 
 /*! \brief This does all post-processing fixup and translation of the Sage III AST.
 
@@ -90,8 +93,10 @@ void postProcessingSupport (SgNode* node);
        3) fixup of ...
        4) ...
 
+    The passes that only need local information run on the files of an SgProject in up to
+    \a nThreads threads (see runPostProcessingPassesOnFiles()); the rest run in the calling thread.
  */
-ROSE_DLL_API void AstPostProcessing(SgNode* node);
+ROSE_DLL_API void AstPostProcessing(SgNode* node, size_t nThreads = 1);
 
 
 #if 0
@@ -1,6 +1,8 @@
 #ifndef ROSE_checkIsCompilerGeneratedFlag_H
 #define ROSE_checkIsCompilerGeneratedFlag_H
 
+#include "postProcessingPasses.h"
+
 /** Checks whether appropriate nodes of an AST are marked as compiler-generated.
  *
  *  The EDG-3.x version of ROSE marks all nodes coming from rose_edg_required_macros_and_functions.h as being
@@ -9,5 +11,22 @@
  *  compiler-generated. */
 size_t checkIsCompilerGeneratedFlag(SgNode *ast);
 
+/** The traversal of checkIsCompilerGeneratedFlag(), as a pass that can be fused with other post-processing passes.  It
+ *  reads the frontend-specific flags of the node, so in a list of passes it must follow CheckIsFrontendSpecificFlag. */
+class CheckIsCompilerGeneratedFlag: public PostProcessingPass {
+public:
+    size_t nviolations;
+
+    CheckIsCompilerGeneratedFlag(): PostProcessingPass("checkIsCompilerGeneratedFlag"), nviolations(0) {
+        dependsOn("checkIsFrontendSpecificFlag");
+    }
+
+protected:
+    void preOrderVisit(SgNode *node);
+
+private:
+    void fix(SgNode *node, Sg_File_Info *finfo);
+};
+
 #endif
 
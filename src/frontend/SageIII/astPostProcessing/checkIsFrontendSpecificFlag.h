@@ -1,11 +1,30 @@
 #ifndef ROSE_checkFrontendSpecificFlag_H
 #define ROSE_checkFrontendSpecificFlag_H
 
+#include "postProcessingPasses.h"
+
 /** Checks whether appropriate nodes of an AST are marked as front-end specific.
  *
  *  A node is frontend-specific if it was parsed from the "rose_edg_required_macros_and_functions.h" or if it has an ancestor
  *  in the AST that is frontend-specific.   All violations are fixed in place.  Returns the number of violations found/fixed. */
 size_t checkIsFrontendSpecificFlag(SgNode *ast);
 
+/** The traversal of checkIsFrontendSpecificFlag(), as a pass that can be fused with other post-processing passes. */
+class CheckIsFrontendSpecificFlag: public PostProcessingPass {
+public:
+    size_t nviolations;
+
+    CheckIsFrontendSpecificFlag(): PostProcessingPass("checkIsFrontendSpecificFlag"), nviolations(0), fes_ast(NULL) {}
+
+protected:
+    void preOrderVisit(SgNode *node);
+    void postOrderVisit(SgNode *node);
+
+private:
+    SgNode *fes_ast; // top node of frontend-specific AST
+
+    bool is_frontend_specific(Sg_File_Info *finfo);
+    void fix(SgNode *node, Sg_File_Info *finfo);
+};
 
 #endif
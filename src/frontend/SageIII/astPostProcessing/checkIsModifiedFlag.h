@@ -1,6 +1,8 @@
 #ifndef CHECK_ISMODIFIED_FLAG_H
 #define CHECK_ISMODIFIED_FLAG_H
 
+#include "postProcessingPasses.h"
+
 #if 0
 // DQ (4/16/2015): Replaced with better implementations.
 bool checkIsModifiedFlag( SgNode *node);
@@ -11,6 +13,16 @@ bool CheckIsModifiedFlagSupport( SgNode *node);
 ROSE_DLL_API void reportNodesMarkedAsModified(SgNode *node);
 ROSE_DLL_API void unsetNodesMarkedAsModified(SgNode *node);
 
+// The traversal of unsetNodesMarkedAsModified(), as a pass that can be fused with other post-processing
+// passes. Passes that modify a node must come before it in the same traversal.
+class UnsetNodesMarkedAsModified : public PostProcessingPass
+   {
+     public:
+          UnsetNodesMarkedAsModified() : PostProcessingPass("unsetNodesMarkedAsModified") {}
+
+          void preOrderVisit (SgNode* node);
+   };
+
 // DQ (4/16/2015): This function is required because it is presently used in the binary analysis.
 // Note that the semantics of this function is that it also resets the isModified flags.
 // It is only used in the binary analysis and we might want to have that location use 
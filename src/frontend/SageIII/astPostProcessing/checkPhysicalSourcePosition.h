@@ -1,11 +1,27 @@
 #ifndef ROSE_checkPhysicalSourcePosition_H
 #define ROSE_checkPhysicalSourcePosition_H
 
+#include "postProcessingPasses.h"
+
 /** Checks whether the physical source position information is consistant in the Sg_File_Info object
  *
  *  New to the EDG 4x work, we now record the logical and physical source position information.
  *  */
 size_t checkPhysicalSourcePosition(SgNode *ast);
 
+/** The traversal of checkPhysicalSourcePosition(), as a pass that can be fused with other post-processing passes. */
+class CheckPhysicalSourcePosition : public PostProcessingPass
+   {
+     public:
+          size_t nviolations;
+
+          CheckPhysicalSourcePosition() : PostProcessingPass("checkPhysicalSourcePosition"), nviolations(0) {}
+
+          void preOrderVisit(SgNode *node);
+
+     private:
+          void check(SgNode *node, Sg_File_Info *finfo);
+   };
+
 #endif
 
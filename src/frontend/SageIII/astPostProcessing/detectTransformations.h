@@ -1,6 +1,8 @@
 #ifndef DETECT_TRANSFORMATIONS_H
 #define DETECT_TRANSFORMATIONS_H
 
+#include "postProcessingPasses.h"
+
 // DQ (5/1/2012): 
 /*! \brief Detect nodes marked as transformations (should not be present coming out of the frontend translation).
  */
@@ -8,17 +10,25 @@ void detectTransformations( SgNode* node );
 
 void detectTransformations_local( SgNode* node );
 
+/*! \brief The memory pool part of detectTransformations(): checks that no Sg_File_Info object is marked as a transformation.
+
+    This is what detectTransformations() adds to a DetectTransformations pass run as part of a fused traversal.
+ */
+void detectTransformationsInMemoryPool();
+
 /*! \brief There sould not be any IR nodes marked as a transformation coming from the EDG/ROSE translation.
            This test enforces this.
 
     \internal This is only for testing the AST after translation.  User transformations would be caught by this 
               and it should not be used downstream of user transformations.
  */
-class DetectTransformations : public SgSimpleProcessing
+class DetectTransformations : public PostProcessingPass
    {
      public:
+          DetectTransformations() : PostProcessingPass("detectTransformations") {}
+
       //! Required traversal function
-          void visit (SgNode* node);
+          void preOrderVisit (SgNode* node);
    };
 
 // endif for DETECT_TRANSFORMATIONS_H
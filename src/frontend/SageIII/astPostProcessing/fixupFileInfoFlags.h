@@ -1,6 +1,8 @@
 #ifndef ROSE_fixupFileInfoFlags_H
 #define ROSE_fixupFileInfoFlags_H
 
+#include "postProcessingPasses.h"
+
 /** Checks and fixes up inconsistanties in the settings of Sg_File_Info flags (e.g. isTransformation flag) in the Sg_File_Info object
  *
  *  We are trying to move the API for setting this into the SgLocatedNode 
@@ -9,5 +11,16 @@
  *  */
 size_t fixupFileInfoInconsistanties(SgNode *ast);
 
+/** The traversal of fixupFileInfoInconsistanties(), as a pass that can be fused with other post-processing passes. */
+class FixupFileInfoInconsistanties : public PostProcessingPass
+   {
+     public:
+          size_t nviolations;
+
+          FixupFileInfoInconsistanties() : PostProcessingPass("fixupFileInfoInconsistanties"), nviolations(0) {}
+
+          void preOrderVisit(SgNode *node);
+   };
+
 #endif
 
@@ -5,6 +5,8 @@
 #ifndef FIXUP_SELF_REFERENTIAL_MACROS_H
 #define FIXUP_SELF_REFERENTIAL_MACROS_H
 
+#include "postProcessingPasses.h"
+
 // DQ (10/5/2012):
 /*! \brief Fixup known macros that reference themselves and cause recursive macro expansion in the generated (unparsed) code.
 
@@ -20,14 +22,23 @@ fixupSelfReferentialMacrosInAST (SgNode* node);
     This is lower level support for the fixupSelfReferentialMacrosInAST(SgNode*) function.
 
  */
-class FixupSelfReferentialMacrosInAST : public AstSimpleProcessing
+class FixupSelfReferentialMacrosInAST : public PostProcessingPass
    {
   // This class uses a traversal to test the values of the definingDeclaration and
   // firstNondefiningDeclaration pointers in each SgDeclarationStatement.  See code for
   // details, since both of these pointers are not always set.
 
+  // This is a local pass: it only adds comments and directives to the parent statement of
+  // an SgInitializedName, which no other post-processing pass reads during the same traversal.
+
      public:
-          void visit ( SgNode* node );
+          FixupSelfReferentialMacrosInAST() : PostProcessingPass("fixupSelfReferentialMacrosInAST") {}
+
+       // The added macros get their own filename in the filename table of Sg_File_Info. That table is not locked, so
+       // this must be called before the pass runs on files in several threads.
+          static void registerMacroFilename();
+
+          void preOrderVisit ( SgNode* node );
    };
 
 // endif for FIXUP_SELF_REFERENTIAL_MACROS_H
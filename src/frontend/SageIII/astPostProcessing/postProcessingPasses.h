@@ -0,0 +1,66 @@
+#ifndef ROSE_postProcessingPasses_H
+#define ROSE_postProcessingPasses_H
+
+#include <string>
+#include <vector>
+
+/** An AST post-processing pass that can share one traversal of the AST with other passes.
+ *
+ *  A pass is local if, when it visits a node, it depends only on the state of that node, its Sg_File_Info objects and its
+ *  ancestors.  It may modify the node and its Sg_File_Info objects, and it may add information to an ancestor that no
+ *  other pass in the same traversal reads.  runPostProcessingPasses() fuses consecutive local passes into one
+ *  AstCombinedPrePostProcessing traversal that calls the passes at each node in list order, so a pass sees the
+ *  effect of the earlier passes on the node and its ancestors but not on the rest of the AST.
+ *
+ *  A pass that depends on the state of other parts of the AST declares that the earlier passes must be complete, and
+ *  then starts a new traversal.  A pass also names the passes it depends on, which must be earlier in the list.
+ *
+ *  runPostProcessingPassesOnFiles() runs a list of passes on the files of a project in several threads, each file with
+ *  its own pass objects.  Passes run that way may read state shared between files (types, symbols of other files, the
+ *  filename table of Sg_File_Info) but must not modify it. */
+class PostProcessingPass: public AstPrePostProcessing {
+public:
+    enum Requirement {
+        LOCAL_STATE,                                    /**< Needs only the node and its ancestors (see above). */
+        COMPLETED_PASSES                                /**< Needs the earlier passes to have finished the whole AST. */
+    };
+
+    PostProcessingPass(const std::string &name, Requirement requirement = LOCAL_STATE)
+        : name_(name), requirement_(requirement) {}
+
+    const std::string& name() const { return name_; }
+    Requirement requirement() const { return requirement_; }
+
+    /** Names of the passes whose effects this pass depends on. */
+    const std::vector<std::string>& dependencies() const { return dependencies_; }
+
+protected:
+    void dependsOn(const std::string &passName) { dependencies_.push_back(passName); }
+
+    // Most passes only need a preorder visit.
+    virtual void postOrderVisit(SgNode*) {}
+
+private:
+    std::string name_;
+    Requirement requirement_;
+    std::vector<std::string> dependencies_;
+};
+
+/** Runs the passes in order on the AST rooted at @p node.
+ *
+ *  Passes are fused into as few traversals as their requirements allow.  Each pass that requires the earlier passes to be
+ *  complete starts a new traversal.  Returns the number of traversals of the AST. */
+size_t runPostProcessingPasses(SgNode *node, const std::vector<PostProcessingPass*> &passes);
+
+/** Creates a new list of passes.  The caller deletes the passes. */
+typedef std::vector<PostProcessingPass*> (*PostProcessingPassListFactory)();
+
+/** Runs a list of passes on each file of @p project, using up to @p nThreads threads.
+ *
+ *  Each file is traversed by a list of passes of its own, made by @p createPasses, so the passes may keep per-traversal
+ *  state.  The files are dealt round-robin to the threads; the passes must not modify anything outside the file they are
+ *  given (see PostProcessingPass).  The SgProject and SgFileList nodes are not traversed.  With one thread the files are
+ *  processed in order in the calling thread. */
+void runPostProcessingPassesOnFiles(SgProject *project, PostProcessingPassListFactory createPasses, size_t nThreads);
+
+#endif
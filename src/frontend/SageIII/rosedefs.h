@@ -5,11 +5,13 @@
 #include "stdio.h"
 #include <cassert>
 #include <cstdio>
+#include <deque>
 #include <list>
 #include <vector>
 #include <string>
 #include <set>
 #include <map>
+#include <new>
 #include <sstream>
 
 // DQ (9/25/2007): Need to move this to here so that all of ROSE will see it.
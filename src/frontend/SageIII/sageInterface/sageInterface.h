@@ -813,6 +813,12 @@ void setSourcePositionPointersToNull(SgNode *node);
 //! Check if a node is from a system header file
   ROSE_DLL_API bool insideSystemHeader (SgLocatedNode* node);
 
+//! Replace the Sg_File_Info objects of all SgLocatedNodes in a subtree by their compact encoding (see SgLocatedNode::compactSourcePosition()). Returns the number of Sg_File_Info objects deleted.
+  ROSE_DLL_API size_t compactSourcePositions (SgNode* root);
+
+//! Replace the Sg_File_Info objects of all SgLocatedNodes in the memory pools by their compact encoding. Returns the number of Sg_File_Info objects deleted.
+  ROSE_DLL_API size_t compactSourcePositions_memoryPool();
+
 //! Set the source position of SgLocatedNode to Sg_File_Info::generateDefaultFileInfo(). These nodes WILL be unparsed. Not for transformation usage.
 // ROSE_DLL_API void setSourcePosition (SgLocatedNode * locatedNode);
 // ************************************************************************
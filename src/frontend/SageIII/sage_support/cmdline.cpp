@@ -12,6 +12,7 @@
 #include "keep_going.h"
 #include "FileUtility.h"
 #include "Diagnostics.h"                                // rose::Diagnostics
+#include "AstConsistencyTests.h"                        // AstTests::set_checkMode()
 
 #include <boost/foreach.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -313,6 +314,7 @@ CommandlineProcessing::isOptionTakingSecondParameter( string argument )
           argument == "-rose:output" ||                     // Used to specify output file to ROSE
           argument == "-rose:o" ||                          // Used to specify output file to ROSE (alternative to -rose:output)
           argument == "-rose:compilationPerformanceFile" || // Use to output performance information about ROSE compilation phases
+          argument == "-rose:astConsistancyTestsMode" ||    // Selects the parts of the AST checked by the AST consistancy tests
           argument == "-rose:verbose" ||                    // Used to specify output of internal information about ROSE phases
           argument == "-rose:log" ||                        // Used to conntrol rose::Diagnostics
           argument == "-rose:assert" ||                     // Controls behavior of failed assertions
@@ -776,6 +778,7 @@ SgProject::processCommandLine(const vector<string>& input_argv)
         }
 
      Rose::Cmdline::ProcessKeepGoing(this, local_commandLineArgumentList);
+     Rose::Cmdline::ProcessFrontendThreads(this, local_commandLineArgumentList);
 
   //
   // Standard compiler options (allows specification of language -x option to just run compiler without /dev/null as input file)
@@ -1625,6 +1628,37 @@ ProcessKeepGoing (SgProject* project, std::vector<std::string>& argv)
   }
 }
 
+void
+Rose::Cmdline::
+ProcessFrontendThreads (SgProject* project, std::vector<std::string>& argv)
+{
+  int frontend_threads = 0;
+  bool has_frontend_threads =
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          "-rose:",
+          "(frontend_threads)",
+          frontend_threads,
+          true);
+
+  if (has_frontend_threads)
+  {
+      if (frontend_threads < 1)
+      {
+          std::cerr
+              << "[FATAL] "
+              << "-rose:frontend_threads requires a positive number of threads"
+              << std::endl;
+          ROSE_ASSERT(false);
+      }
+
+      if (SgProject::get_verbose() >= 1)
+          std::cout << "[INFO] [Cmdline] [-rose:frontend_threads " << frontend_threads << "]" << std::endl;
+
+      project->set_frontendThreads(frontend_threads);
+  }
+}
+
 //------------------------------------------------------------------------------
 //                                  Unparser
 //------------------------------------------------------------------------------
@@ -3032,6 +3066,10 @@ SgFile::usage ( int status )
 "                             try to compile as much as possible, ignoring failures,\n"
 "                             in order to gauage the overall status of your translator,\n"
 "                             with respect to that application.\n"
+"     -rose:frontend_threads N\n"
+"                             post-process the files of a multi-file command line\n"
+"                             with up to N threads (default 1); the passes that\n"
+"                             only need one file run concurrently\n"
 "\n"
 "Operation modifiers:\n"
 "     -rose:output_warnings   compile with warnings mode on\n"
@@ -3185,6 +3223,13 @@ SgFile::usage ( int status )
 "                             file format for binaries)\n"
 "     -rose:skipAstConsistancyTests\n"
 "                             skip AST consitancy testing (for better performance)\n"
+"     -rose:astConsistancyTestsMode MODE\n"
+"                             comma separated list of: all (check the whole AST,\n"
+"                             default), sample[=FRACTION] (check a random fraction\n"
+"                             of the declarations in global scope, default 0.1),\n"
+"                             changed (check the declarations in global scope that\n"
+"                             changed since the previous check), parallel (run the\n"
+"                             structural tests on a separate thread)\n"
 "\n"
 "GNU g++ options recognized:\n"
 "     -ansi                   equivalent to -rose:strict\n"
@@ -5274,6 +5319,16 @@ SgFile::processRoseCommandLineOptions ( vector<string> & argv )
           set_skipAstConsistancyTests(true);
         }
 
+  // Check only part of the AST, and/or run some of the AST consistancy tests in parallel.
+     std::string astConsistancyTestsMode;
+     if ( CommandlineProcessing::isOptionWithParameter(argv,"-rose:","(astConsistancyTestsMode)",astConsistancyTestsMode,true) == true )
+        {
+          if (AstTests::set_checkMode(astConsistancyTestsMode) == false)
+             {
+               printf ("Warning: invalid -rose:astConsistancyTestsMode \"%s\" (ignored) \n",astConsistancyTestsMode.c_str());
+             }
+        }
+
   //
   // internal testing option (for internal use only, these may disappear at some point)
   //
@@ -5516,6 +5571,7 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      optionCount = sla(argv, "-rose:", "($)^", "(log)", loggingSpec, 1);
      optionCount = sla(argv, "-rose:", "($)", "(keep_going)",1);
      int integerOption = 0;
+     optionCount = sla(argv, "-rose:", "($)^", "(frontend_threads)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(v|verbose)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(upc_threads)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)", "(C|C_only)",1);
@@ -5696,6 +5752,7 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
 
   // DQ (2/17/2013): Added support for skipping AST consistancy testing (for performance evaluation).
      optionCount = sla(argv, "-rose:", "($)", "(skipAstConsistancyTests)",1);
+     optionCount = sla(argv, "-rose:", "($)^", "(astConsistancyTestsMode)",filename,1);
 
   // DQ (6/8/2013): Added support for experimental fortran frontend.
      optionCount = sla(argv, "-rose:", "($)", "(experimental_fortran_frontend)",1);
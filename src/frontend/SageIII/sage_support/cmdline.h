@@ -65,6 +65,12 @@ namespace Cmdline {
   void
   ProcessKeepGoing (SgProject* project, std::vector<std::string>& argv);
 
+  /** Processes -rose:frontend_threads N, the number of threads that post-process the files of the project (see
+   *  AstPostProcessing()).
+   */
+  void
+  ProcessFrontendThreads (SgProject* project, std::vector<std::string>& argv);
+
   namespace Unparser {
     static const std::string option_prefix = "-rose:unparser:";
 
@@ -2012,7 +2012,9 @@ SgProject::parse()
 #ifndef ROSE_USE_CLANG_FRONTEND
      if ( (get_fileList().empty() == false) && (get_useBackendOnly() == false) )
         {
-          AstPostProcessing(this);
+       // The files are parsed one after another (EDG and the comment and directive lexer keep global state), but the
+       // post-processing passes that only need one file can run on the files concurrently (-rose:frontend_threads N).
+          AstPostProcessing(this, get_frontendThreads());
         }
 #endif
 #if 0
@@ -6365,8 +6367,14 @@ int SgProject::link ( const std::vector<std::string>& argv, std::string linkerNa
   // There will be no SgFile at all in this case but we still want to append relevant linking options for OpenMP
      if (SageInterface::getProject()->get_openmp_linking())
         {
+#if defined(USE_ROSE_NATIVE_OPENMP_LIBRARY)
+       // the native XOMP runtime is self-contained in libxomp.a
+          string xomp_lib_path(ROSE_INSTALLATION_PATH);
+          ROSE_ASSERT (xomp_lib_path.size() != 0);
+          linkingCommand.push_back(xomp_lib_path+"/lib/libxomp.a");
+          linkingCommand.push_back("-lpthread");
 // Sara Royuela 12/10/2012:  Add GCC version check
-#ifdef USE_ROSE_GOMP_OPENMP_LIBRARY
+#elif defined(USE_ROSE_GOMP_OPENMP_LIBRARY)
 #if (__GNUC__ < 4 || (__GNUC__ == 4 && (__GNUC_MINOR__ < 4)))
 #warning "GNU version lower than expected"    
           printf("GCC version must be 4.4.0 or later when linking with GOMP OpenMP Runtime Library \n(OpenMP tasking calls are not implemented in previous versions)\n");
@@ -6463,6 +6471,13 @@ namespace AST_FileIO
        // printf ("In AST_FileIO::TO_BE_COPIED_POINTER(): value = %p \n",value);
           return value;
         }
+
+  // marks the memory pool entries reserved for lazily loaded function bodies
+     SgNode* IS_DEFERRED_POINTER()
+        {
+          static SgNode* value = (SgNode*)((std::string::npos) - 2);
+          return value;
+        }
    }
 
 
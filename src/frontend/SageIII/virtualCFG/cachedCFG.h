@@ -0,0 +1,172 @@
+#ifndef CACHED_CFG_H
+#define CACHED_CFG_H
+
+#include "virtualCFG.h"
+#include <boost/unordered_map.hpp>
+#include <vector>
+
+class SgFunctionDefinition;
+
+namespace VirtualCFG {
+
+  //! A materialized, per-function snapshot of the virtual CFG.
+  //!
+  //! CFGNode::outEdges() and CFGNode::inEdges() derive edges from the AST on
+  //! every call, which is expensive when an analysis visits each node many
+  //! times.  A CachedCFG walks the virtual CFG of one function once, gives each
+  //! CFG node a dense ID in [0, size()), and stores the edges in both
+  //! directions as compressed sparse row (CSR) arrays.  The accessors return
+  //! references into those arrays, so iterating over successors or
+  //! predecessors does no allocation.
+  //!
+  //! Use CachedCFG::get() to share one cache per function between analyses.
+  //! The cached graph is rebuilt automatically when any AST node it was built
+  //! from becomes marked as modified (SgNode::get_isModified()) or gains or
+  //! loses traversal successors.  Modifications that do neither (e.g., edits
+  //! made after the isModified flags were reset, or deleting AST nodes) must
+  //! be announced with invalidate().  The cache is not thread-safe.
+  class ROSE_DLL_API CachedCFG {
+    public:
+    //! Dense node identifier
+    typedef unsigned int NodeId;
+
+    //! Returned by id() for nodes that are not part of the function
+    static const NodeId INVALID_ID = (NodeId)(-1);
+
+    //! A filtered view of a cached CFG.  Only nodes satisfying the filter are
+    //! present; each edge of the view is a path through the unfiltered graph
+    //! whose interior nodes do not satisfy the filter (as with
+    //! InterestingNode and InterestingEdge).
+    class ROSE_DLL_API View {
+      friend class CachedCFG;
+      const CachedCFG* base;
+      std::vector<NodeId> baseIds;             // view ID -> base ID
+      std::vector<NodeId> viewIds;             // base ID -> view ID, or INVALID_ID
+      std::vector<unsigned int> outOffsets;    // CSR row offsets into outPaths/outTargets
+      std::vector<NodeId> outTargets;          // view IDs of successors
+      std::vector<CFGPath> outPaths;
+      std::vector<unsigned int> inOffsets;     // CSR row offsets into inEdgeIndices
+      std::vector<unsigned int> inEdgeIndices; // indices into outPaths/outTargets
+      std::vector<NodeId> inSources;           // view IDs of predecessors
+
+      public:
+      View(): base(NULL) {}
+
+      //! Number of nodes in the view
+      size_t size() const {return baseIds.size();}
+      //! ID of the node in the underlying cached CFG
+      NodeId baseId(NodeId v) const {return baseIds[v];}
+      //! ID of a node of the underlying cached CFG within this view, or INVALID_ID
+      NodeId viewId(NodeId b) const {return b < viewIds.size() ? viewIds[b] : INVALID_ID;}
+      //! The CFG node for a view ID
+      const CFGNode& node(NodeId v) const;
+
+      //! Number of successors of a node
+      size_t nSuccessors(NodeId v) const {return outOffsets[v+1] - outOffsets[v];}
+      //! View IDs of the successors of a node
+      const NodeId* successorsBegin(NodeId v) const {return outTargets.empty() ? NULL : &outTargets[0] + outOffsets[v];}
+      const NodeId* successorsEnd(NodeId v) const {return outTargets.empty() ? NULL : &outTargets[0] + outOffsets[v+1];}
+      //! The i'th outgoing path of a node
+      const CFGPath& outPath(NodeId v, size_t i) const {return outPaths[outOffsets[v] + i];}
+
+      //! Number of predecessors of a node
+      size_t nPredecessors(NodeId v) const {return inOffsets[v+1] - inOffsets[v];}
+      //! View IDs of the predecessors of a node
+      const NodeId* predecessorsBegin(NodeId v) const {return inSources.empty() ? NULL : &inSources[0] + inOffsets[v];}
+      const NodeId* predecessorsEnd(NodeId v) const {return inSources.empty() ? NULL : &inSources[0] + inOffsets[v+1];}
+      //! The i'th incoming path of a node
+      const CFGPath& inPath(NodeId v, size_t i) const {return outPaths[inEdgeIndices[inOffsets[v] + i]];}
+    };
+
+    //! Materialize the CFG of a function.  Prefer get(), which caches the
+    //! result.
+    explicit CachedCFG(SgFunctionDefinition* func);
+
+    //! The cached CFG for a function, building or rebuilding it if necessary.
+    //! The returned reference stays valid until the function's CFG is rebuilt
+    //! or invalidated.
+    static const CachedCFG& get(SgFunctionDefinition* func);
+    //! Discard the cached CFG of one function
+    static void invalidate(SgFunctionDefinition* func);
+    //! Discard all cached CFGs
+    static void invalidateAll();
+
+    //! True if none of the AST nodes this CFG was built from have been
+    //! modified since it was built
+    bool isCurrent() const;
+
+    //! The function whose CFG this is
+    SgFunctionDefinition* getFunction() const {return func;}
+    //! Number of CFG nodes
+    size_t size() const {return nodes.size();}
+    //! The CFG node with the given ID
+    const CFGNode& node(NodeId n) const {return nodes[n];}
+    //! The ID of a CFG node, or INVALID_ID if it is not part of this CFG
+    NodeId id(const CFGNode& n) const;
+    //! ID of the function entry node (cfgBeginningOfConstruct of the function definition)
+    NodeId getEntry() const {return entryId;}
+    //! ID of the function exit node (cfgEndOfConstruct of the function definition)
+    NodeId getExit() const {return exitId;}
+
+    //! Number of outgoing edges of a node
+    size_t nSuccessors(NodeId n) const {return outOffsets[n+1] - outOffsets[n];}
+    //! IDs of the successors of a node, as a contiguous range
+    const NodeId* successorsBegin(NodeId n) const {return outTargets.empty() ? NULL : &outTargets[0] + outOffsets[n];}
+    const NodeId* successorsEnd(NodeId n) const {return outTargets.empty() ? NULL : &outTargets[0] + outOffsets[n+1];}
+    //! The i'th outgoing edge of a node
+    const CFGEdge& outEdge(NodeId n, size_t i) const {return edges[outOffsets[n] + i];}
+
+    //! Number of incoming edges of a node
+    size_t nPredecessors(NodeId n) const {return inOffsets[n+1] - inOffsets[n];}
+    //! IDs of the predecessors of a node, as a contiguous range
+    const NodeId* predecessorsBegin(NodeId n) const {return inSources.empty() ? NULL : &inSources[0] + inOffsets[n];}
+    const NodeId* predecessorsEnd(NodeId n) const {return inSources.empty() ? NULL : &inSources[0] + inOffsets[n+1];}
+    //! The i'th incoming edge of a node
+    const CFGEdge& inEdge(NodeId n, size_t i) const {return edges[inEdgeIndices[inOffsets[n] + i]];}
+
+    //! Drop-in replacements for CFGNode::outEdges() and CFGNode::inEdges()
+    std::vector<CFGEdge> outEdges(NodeId n) const;
+    std::vector<CFGEdge> inEdges(NodeId n) const;
+
+    //! Build a view containing the nodes for which filter(CFGNode) is true.
+    //! The filter may be a function pointer or a function object.
+    template <class FilterFunction>
+    View makeView(FilterFunction filter) const {
+      std::vector<bool> keep(nodes.size());
+      for (size_t i = 0; i < nodes.size(); ++i)
+        keep[i] = filter(nodes[i]);
+      return makeViewFromMask(keep);
+    }
+
+    //! View containing the nodes satisfying CFGNode::isInteresting()
+    View makeInterestingView() const;
+
+    private:
+    View makeViewFromMask(const std::vector<bool>& keep) const;
+
+    struct CFGNodeHash {
+      size_t operator()(const CFGNode& n) const {
+        return ((size_t)n.getNode() >> 3) ^ ((size_t)n.getIndex() * 0x9e3779b9u);
+      }
+    };
+
+    SgFunctionDefinition* func;
+    std::vector<CFGNode> nodes;                         // ID -> node
+    boost::unordered_map<CFGNode, NodeId, CFGNodeHash> ids;
+    NodeId entryId, exitId;
+    std::vector<unsigned int> outOffsets;               // CSR row offsets into edges/outTargets
+    std::vector<CFGEdge> edges;                         // all edges, grouped by source ID
+    std::vector<NodeId> outTargets;                     // target ID of each edge
+    std::vector<unsigned int> inOffsets;                // CSR row offsets into inEdgeIndices/inSources
+    std::vector<unsigned int> inEdgeIndices;            // edges grouped by target ID
+    std::vector<NodeId> inSources;                      // source ID of each incoming edge
+
+    // Snapshot of the AST nodes the CFG was derived from, used by isCurrent()
+    std::vector<SgNode*> astNodes;
+    std::vector<size_t> astNodeSuccessors;
+    std::vector<bool> astNodeWasModified;
+  };
+
+} // end namespace VirtualCFG
+
+#endif // CACHED_CFG_H
@@ -7,6 +7,8 @@
 // DQ (12/7/2003): use platform independent macro defined in config.h
 // #include IOSTREAM_HEADER_FILE
 #include <iostream>
+#include <map>
+#include <set>
 
 #include "rosedll.h"
 #include "AstStatistics.h"
@@ -19,6 +21,8 @@
    #include "AstReverseProcessing.h"
 #endif
 
+class AstTestsSubtreeSelection;
+
 class TestAstPropertiesSA 
    {
      public:
@@ -45,7 +49,15 @@ class TestAstProperties : public AstBottomUpProcessing<TestAstPropertiesSA>
 
           TestAstProperties();
 
+       // Restricts the test to the selected subtrees (see AstTestsSubtreeSelection)
+          void set_selection(const AstTestsSubtreeSelection* s);
+
+     protected:
+          void setNodeSuccessors(SgNode* node, std::vector<SgNode*> & succContainer);
+
      private:
+          const AstTestsSubtreeSelection* selection;
+
           TestAstPropertiesSA evaluateSynthesizedAttribute(SgNode* node, SubTreeSynthesizedAttributes l);
    };
 
@@ -63,7 +75,66 @@ class ROSE_DLL_API AstTests
 
        //! Test codes that traverse the AST
           static void runAllTests(SgProject* sageProject);
-          static bool isCorrectAst(SgProject* sageProject);
+          static bool isCorrectAst(SgProject* sageProject, const AstTestsSubtreeSelection* selection = NULL);
+
+       //! Which parts of the AST runAllTests() checks.  Checking a sample or only the changed parts runs just the
+       //! tests that are traversals of the AST, and only over the selected declarations in global scope (see
+       //! AstTestsSubtreeSelection); the tests that iterate over the memory pools are skipped.
+          enum CheckScope
+             {
+               e_checkAll,          //!< all IR nodes (default)
+               e_checkSample,       //!< a random fraction of the declarations in global scope, different for each call
+               e_checkChanged       //!< declarations in global scope that changed since the previous call
+             };
+
+          static void set_checkScope(CheckScope scope, double sampleFraction = 0.1);
+          static CheckScope get_checkScope();
+          static double get_sampleFraction();
+
+       //! When true, runAllTests() runs the tests that only read the AST structure (cycles, unique IR nodes)
+       //! concurrently with each other, before the other tests start (default false).  The other tests build types
+       //! and mangled names, so they never run concurrently with anything.
+          static void set_checkInParallel(bool parallel);
+          static bool get_checkInParallel();
+
+       //! Sets the options above from a comma-separated list of "all", "sample", "sample=FRACTION", "changed" and
+       //! "parallel" (the argument of -rose:astConsistancyTestsMode).  Returns false if the list is not valid.
+          static bool set_checkMode(const std::string & mode);
+   };
+
+//! Declarations in global scope that AstTests::runAllTests() checks.
+//!
+//! The traversal based tests visit the IR nodes above global scope and, of the declarations in global scope, only the
+//! selected ones and their subtrees.  A declaration has changed if one of the IR nodes in its subtree was added,
+//! removed or replaced, or had one of its pointers set, since the previous check (see commit()).  A declaration with
+//! an IR node that is marked as modified is checked every time, since a second change to that IR node can not be told
+//! from the first; the flags are not cleared here, because the unparsers use them (see unsetNodesMarkedAsModified()).
+//! The signatures that tell whether a declaration changed are computed again only after SgNode::get_modificationEpoch()
+//! advanced, so checking an unchanged AST does not traverse it.
+class ROSE_DLL_API AstTestsSubtreeSelection
+   {
+     public:
+          AstTestsSubtreeSelection(SgProject* project, AstTests::CheckScope scope, double sampleFraction);
+
+       //! True if every declaration is selected
+          bool isComplete() const { return scope == AstTests::e_checkAll; }
+
+          bool isSelected(SgNode* declaration) const;
+
+       //! Replaces the unselected declarations among the successors of node by NULL
+          void selectSuccessors(SgNode* node, std::vector<SgNode*> & successors) const;
+
+          size_t numberOfSelected() const { return selected.size(); }
+          size_t numberOfDeclarations() const { return nDeclarations; }
+
+       //! Remembers the declarations as checked, so that checking the changed declarations next time skips them
+          void commit() const;
+
+     private:
+          AstTests::CheckScope scope;
+          size_t nDeclarations;
+          std::set<SgNode*> selected;
+          std::map<SgNode*,size_t> signatures;
    };
 
 #ifndef SWIG
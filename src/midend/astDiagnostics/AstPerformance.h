@@ -17,6 +17,7 @@
 #include <assert.h>
 
 #include "rosedll.h"
+#include "PhaseTracing.h"
 
 /*! \brief This is a mechanism for reporting the performance of processing of the AST, subtrees, 
            and IR nodes.  
@@ -190,6 +191,10 @@ class ROSE_DLL_API AstPerformance
 
           bool outputReportInDestructor;
 
+       // Thread that created this performance monitor (see rose::PhaseTracing::threadIndex()); the parent of a
+       // performance monitor is the innermost one created by the same thread.
+          unsigned threadIndex;
+
           void generateReportFromObject() const;
           void generateReportToFile( SgProject* project ) const;
           static void generateReport();
@@ -225,6 +230,9 @@ class ROSE_DLL_API TimingPerformance : public AstPerformance
      private:
           RoseTimeType timer;
 
+       // Also records the phase as a trace event when phase tracing is enabled (see PhaseTracing.h).
+          rose::PhaseTracing::Scope traceScope;
+
   // Used for timing compilation within ROSE
      public:
           TimingPerformance ( std::string s , bool outputReport = false );
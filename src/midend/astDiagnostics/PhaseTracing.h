@@ -0,0 +1,133 @@
+#ifndef ROSE_PhaseTracing_H
+#define ROSE_PhaseTracing_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include "rosedll.h"
+
+namespace rose {
+
+/** Low-overhead tracing of processing phases.
+ *
+ *  A phase is traced by constructing a Scope object (usually with the ROSE_TRACE_SCOPE macro) whose lifetime covers the
+ *  phase.  Each thread appends completed scopes to its own fixed-size ring buffer; recording an event takes no locks and
+ *  allocates no memory, and when tracing is disabled a scope costs one test of a global flag.  Defining
+ *  ROSE_DISABLE_TRACING when compiling removes ROSE_TRACE_SCOPE entirely.
+ *
+ *  The collected events can be written in two formats:
+ *
+ *  @li writeChromeTrace() emits the JSON "Trace Event Format" understood by chrome://tracing and the Perfetto UI, one
+ *      track per thread.
+ *
+ *  @li writeFoldedStacks() emits one line per distinct call stack followed by its self time in microseconds, the input
+ *      format of flamegraph.pl, speedscope and similar tools.
+ *
+ *  Tracing is enabled either by calling enable() or by setting the environment variable ROSE_TRACE to the name of a Chrome
+ *  trace file, and/or ROSE_TRACE_FOLDED to the name of a folded-stacks file; those files are written when the process exits.
+ *  Every TimingPerformance object (see AstPerformance.h) is also a trace scope, so the frontend, AST post-processing,
+ *  unparser and backend phases appear in traces without further changes.
+ *
+ * @code
+ *  void MyAnalysis::run() {
+ *      ROSE_TRACE_SCOPE("MyAnalysis::run");
+ *      ...
+ *  }
+ * @endcode
+ *
+ *  The ring buffers are written without synchronization, so the writers should be called when the traced threads are
+ *  idle (e.g., after joining them, or at exit).  When a thread records more events than its buffer holds, its oldest
+ *  events are overwritten. */
+namespace PhaseTracing {
+
+/** Current time in microseconds; the same clock as the TimingPerformance timers. */
+ROSE_DLL_API unsigned long long now();
+
+/** Whether scopes are being recorded.
+ *
+ * @{ */
+extern ROSE_DLL_API bool enabled_;
+inline bool isEnabled() { return enabled_; }
+ROSE_DLL_API void enable(bool b = true);
+/** @} */
+
+/** Number of events retained per thread.
+ *
+ *  Changing the capacity affects only the buffers of threads that have not yet recorded an event.  The default is 65536.
+ *
+ * @{ */
+ROSE_DLL_API size_t bufferCapacity();
+ROSE_DLL_API void bufferCapacity(size_t nEvents);
+/** @} */
+
+/** Small integer identifying the calling thread; the first thread to ask gets zero. */
+ROSE_DLL_API unsigned threadIndex();
+
+/** Name of the calling thread's track in the output.  Threads that are not named are called "thread N". */
+ROSE_DLL_API void setThreadName(const std::string &name);
+
+/** Returns a copy of @p s whose address stays valid until the program exits.  Used for scope names that are not
+ *  string literals; interning the same string twice returns the same pointer. */
+ROSE_DLL_API const char* intern(const std::string &s);
+
+/** Write all recorded events in Chrome/Perfetto JSON format. */
+ROSE_DLL_API void writeChromeTrace(std::ostream&);
+
+/** Write the recorded events as folded stacks for flame graphs. */
+ROSE_DLL_API void writeFoldedStacks(std::ostream&);
+
+/** Discard all recorded events. */
+ROSE_DLL_API void clear();
+
+struct ThreadBuffer;
+
+/** Records the time from its construction to its destruction as one event of the calling thread.
+ *
+ *  The name must outlive the trace (string literals do); names built at run time are interned.  A scope constructed while
+ *  tracing is disabled records nothing even if tracing is enabled before it is destroyed. */
+class ROSE_DLL_API Scope {
+    ThreadBuffer *buffer_;
+    const char *name_;
+    unsigned long long begin_;
+
+    // not copyable
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+public:
+    explicit Scope(const char *name): buffer_(NULL), name_(name), begin_(0) {
+        if (isEnabled())
+            start();
+    }
+
+    explicit Scope(const std::string &name): buffer_(NULL), name_(NULL), begin_(0) {
+        if (isEnabled()) {
+            name_ = intern(name);
+            start();
+        }
+    }
+
+    ~Scope() {
+        if (buffer_)
+            stop();
+    }
+
+private:
+    void start();
+    void stop();
+};
+
+} // namespace
+} // namespace
+
+#ifdef ROSE_DISABLE_TRACING
+# define ROSE_TRACE_SCOPE(NAME) ((void)0)
+#else
+# define ROSE_TRACE_SCOPE_CAT2(A, B) A ## B
+# define ROSE_TRACE_SCOPE_CAT(A, B) ROSE_TRACE_SCOPE_CAT2(A, B)
+/** Traces the rest of the enclosing block as a phase named @p NAME. */
+# define ROSE_TRACE_SCOPE(NAME) ::rose::PhaseTracing::Scope ROSE_TRACE_SCOPE_CAT(roseTraceScope_, __LINE__)(NAME)
+#endif
+
+#endif
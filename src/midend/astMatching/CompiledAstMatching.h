@@ -0,0 +1,119 @@
+#ifndef COMPILED_AST_MATCHING_H
+#define COMPILED_AST_MATCHING_H
+
+#include "matcherparser_decls.h"
+#include "MatchOperation.h"
+#include <string>
+#include <vector>
+#include <map>
+
+class SgNode;
+
+/*! \brief One successful match of a CompiledAstMatching pattern.
+ */
+struct CompiledAstMatch {
+  //! index of the pattern as returned by CompiledAstMatching::addPattern
+  size_t pattern;
+  //! node at which the pattern was matched (null for patterns that match null values)
+  SgNode* node;
+  //! variable bindings of this match (empty if the pattern has no variables)
+  SingleMatchVarBindings varBindings;
+};
+
+typedef std::vector<CompiledAstMatch> CompiledAstMatchResult;
+
+/*!
+  \brief Matches many AstMatching patterns in a single traversal of the AST.
+
+  \details AstMatching interprets the match operation sequence of one
+  pattern at every node of the AST. CompiledAstMatching parses each
+  pattern with the same parser and compiles its match operation
+  sequence into a pattern tree whose node checks compare variants
+  instead of typeid names. All patterns are then combined into one
+  decision table indexed by variantT(): for each variant it lists the
+  patterns whose root can match a node of that variant, so at every
+  node of the AST only the candidate patterns are evaluated.
+
+  The results are the same as with one AstMatching object per
+  pattern, with these differences: a match is reported even if the
+  pattern binds no variable; nodes marked with '#' are excluded only
+  from the subsequent matches of the pattern that marked them; '..' in
+  a nested term matches the remaining children of that term, and the
+  bindings made before a '|' in the same term are kept.
+
+  \code
+  CompiledAstMatching m;
+  size_t assignments=m.addPattern("$R=SgAssignOp($L=SgVarRefExp,$E)");
+  size_t calls=m.addPattern("$C=SgFunctionCallExp(..)");
+  CompiledAstMatchResult res=m.performMatching(root);
+  \endcode
+*/
+class CompiledAstMatching {
+ public:
+  CompiledAstMatching();
+  ~CompiledAstMatching();
+  /* Parses and compiles a match expression. Returns the index of the
+     pattern, which identifies its matches in the result.
+   */
+  size_t addPattern(std::string matchExpression);
+  size_t numberOfPatterns() const;
+  /* Matches all patterns on the AST rooted at 'root' in one
+     traversal. The matches are ordered by node (in the order of the
+     RoseAst iterator) and, at the same node, by pattern index.
+  */
+  CompiledAstMatchResult performMatching(SgNode* root);
+  CompiledAstMatchResult getResult();
+  /* The variable bindings of the matches of one pattern, in the same
+     format as AstMatching::getResult (matches without bindings are
+     left out).
+  */
+  MatchResult getResult(size_t pattern);
+  /* This function is only for information purposes. It prints the
+     compiled pattern trees and the number of candidate patterns in
+     the decision table.
+  */
+  void printAutomaton();
+
+ private:
+  struct PatternNode {
+    enum Kind { ANY, VARIANT, NULL_NODE, NEVER, OR, DOTDOT };
+    PatternNode();
+    Kind kind;
+    VariantT variant;
+    bool mark;
+    std::vector<std::string> varNames;
+    // a node with children is a term; otherwise the subtree is not checked
+    bool hasChildren;
+    size_t minArity;
+    size_t maxArity;
+    std::vector<PatternNode*> children;
+    PatternNode* left;
+    PatternNode* right;
+  };
+  typedef std::vector<std::pair<const std::string*,SgNode*> > Bindings;
+  typedef std::vector<SgNode*> Marks;
+
+  PatternNode* newPatternNode();
+  PatternNode* compileNode(MatchOperationList::iterator& i, MatchOperationList::iterator end);
+  PatternNode* compileSequence(MatchOperationList* sequence);
+  void addRootVariants(PatternNode* p, size_t pattern);
+  bool matchNode(PatternNode* p, SgNode* node, Bindings& bindings, Marks& marks);
+  void tryPatterns(const std::vector<size_t>& candidates, SgNode* node);
+  std::string toString(PatternNode* p);
+  VariantT variantOfClassName(const std::string& className);
+
+  std::vector<PatternNode*> _patterns;
+  std::vector<std::string> _matchExpressions;
+  std::vector<PatternNode*> _allocatedNodes;
+  // decision table: candidate patterns by variant of the node, and for null values
+  std::vector<std::vector<size_t> > _candidatesByVariant;
+  std::vector<size_t> _nullCandidates;
+  std::map<std::string,VariantT> _variantsByName;
+
+  // state of a matching run
+  CompiledAstMatchResult _result;
+  std::map<SgNode*,std::vector<size_t> > _markedBy;
+  std::vector<size_t> _suppressed;
+};
+
+#endif
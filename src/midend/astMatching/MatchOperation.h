@@ -82,6 +82,8 @@ class MatchOpOr : public MatchOperation {
  MatchOpOr(MatchOpSequence* l, MatchOpSequence* r):_left(l),_right(r){}
   std::string toString();
   bool performOperation(MatchStatus& status, RoseAst::iterator& i, SingleMatchResult& vb);
+  MatchOpSequence* getLeft() { return _left; }
+  MatchOpSequence* getRight() { return _right; }
  private:
   MatchOpSequence* _left;
   MatchOpSequence* _right;
@@ -92,6 +94,7 @@ class MatchOpVariableAssignment : public MatchOperation {
   MatchOpVariableAssignment(std::string varName);
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  std::string getVarName() { return _varName; }
  private:
   std::string _varName;
 };
@@ -101,8 +104,11 @@ class MatchOpCheckNode : public MatchOperation {
   MatchOpCheckNode(std::string nodename);
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  // name of the node class as written in the pattern
+  std::string getClassName() { return _classname; }
  private:
   std::string _nodename;
+  std::string _classname;
 };
 
 class MatchOpCheckNodeSet : public MatchOperation {
@@ -120,6 +126,8 @@ class MatchOpArityCheck : public MatchOperation {
   MatchOpArityCheck(size_t minarity, size_t maxarity);
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  size_t getMinArity() { return _minarity; }
+  size_t getMaxArity() { return _maxarity; }
  private:
   size_t _minarity;
   size_t _maxarity;
@@ -3,9 +3,14 @@
 
 #include "rosedll.h"
 #include "rose_override.h"
+#include <Sawyer/Assert.h>
 #include <Sawyer/Attribute.h>
+#include <Sawyer/SmallObject.h>
+#include <boost/unordered_map.hpp>
+#include <deque>
 #include <list>
 #include <set>
+#include <vector>
 
 class SgNode;
 class SgNamedType;
@@ -246,12 +251,30 @@ public:
  *  pointers. The amount of boilerplate that needs to be written in order to store a @ref Sawyer::Attribute is much less than
  *  that required to store an attribute with @ref AstAttributeMechanism.
  *
+ *  Each attribute name is registered once with the @ref Sawyer::Attribute name space, which assigns it an integer ID. The
+ *  string-keyed methods look up that ID on every call; code that accesses an attribute often can look the ID up once with
+ *  @ref declare and then use the methods that take the ID.  Analyses that attach a value of one type to many nodes should
+ *  consider an @ref AstAttributeTable instead, which stores the values themselves rather than heap-allocated attributes.
+ *
+ *  Containers are allocated from a pool, since each IR node that has attributes has its own container.
+ *
  *  For additional information, including examples, see @ref attributes. */
-class ROSE_DLL_API AstAttributeMechanism {
+class ROSE_DLL_API AstAttributeMechanism: public Sawyer::SmallObject {
     // Use containment because we want to keep the original API.
     Sawyer::Attribute::Storage<> attributes_;
 
 public:
+    /** Attribute ID.
+     *
+     *  The integer that identifies an attribute name. */
+    typedef Sawyer::Attribute::Id Id;
+
+    /** Register an attribute name.
+     *
+     *  Returns the ID for the specified attribute name, registering the name if this is its first use. The ID is the same for
+     *  the life of the program. */
+    static Id declare(const std::string &name);
+
     /** Default constructor.
      *
      *  Constructs an attribute mechanism that holds no attributes. */
@@ -298,8 +321,12 @@ public:
      *  exists and points to a non-null attribute value.  The name need not be declared in the attribute system.
      *
      *  <b>New semantics:</b> It is now permissible to invoke this method on a const attribute container and this method no
-     *  longer copies the name argument. */
+     *  longer copies the name argument.
+     *
+     *  @{ */
     bool exists(const std::string &name) const;
+    bool exists(Id id) const;
+    /** @} */
 
     /** Insert an attribute.
      *
@@ -316,8 +343,12 @@ public:
      *
      *  <b>New semantics:</b> The old implementation didn't delete the previous attribute value.  The old implementation
      *  allowed setting a null value, in which case the old @c exists returned true but the @c operator[] returned no
-     *  attribute. */
+     *  attribute.
+     *
+     *  @{ */
     void set(const std::string &name, AstAttribute *value);
+    void set(Id id, AstAttribute *value);
+    /** @} */
 
     /** Insert a new value if the attribute doesn't already exist.
      *
@@ -328,8 +359,12 @@ public:
      *  ownership of an attribute that wasn't inserted, but it also didn't indicate whether it was inserted.  The old
      *  implementation printed an error message on standard error if the attribute existed (even if only its name existed but
      *  it had no value) and then returned to the caller without doing anything. Inserting a null value was allowed by the old
-     *  implementation, in which case the old @c exists returned true but the old @c operator[] returned no attribute. */
+     *  implementation, in which case the old @c exists returned true but the old @c operator[] returned no attribute.
+     *
+     *  @{ */
     bool add(const std::string &name, AstAttribute *value);
+    bool add(Id id, AstAttribute *value);
+    /** @} */
 
     /** Insert a new value if the attribute already exists.
      *
@@ -340,8 +375,12 @@ public:
      *  ownership of an attribute that wasn't inserted, but it also didn't indicate whether it was inserted. The old
      *  implementation printed an error message on standard error if the attribute didn't exist and then returned to the caller
      *  without doing anything. Inserting a null value was allowed by the old implementation, in which case the old @c exists
-     *  returned true but the old @c operator[] returned no attribute. */
+     *  returned true but the old @c operator[] returned no attribute.
+     *
+     *  @{ */
     bool replace(const std::string &name, AstAttribute *value);
+    bool replace(Id id, AstAttribute *value);
+    /** @} */
 
     /** Get an attribute value.
      *
@@ -355,8 +394,12 @@ public:
      *
      *  <b>New semantics:</b> The old implementation partly created an attribute if it didn't exist: @c exists started
      *  returning true although @c operator[] continued to return no attribute. The old implementation printed an error message
-     *  to standard error if the attribute did not exist. */
+     *  to standard error if the attribute did not exist.
+     *
+     *  @{ */
     AstAttribute* operator[](const std::string &name) const;
+    AstAttribute* operator[](Id id) const;
+    /** @} */
 
     /** Erases the specified attribute.
      *
@@ -366,8 +409,12 @@ public:
      *  after this method returns.
      *
      *  <b>New semantics:</b> The old implementation did not delete the attribute value. It also printed an error message
-     *  to standard error if the attribute did not exist. */
+     *  to standard error if the attribute did not exist.
+     *
+     *  @{ */
     void remove(const std::string &name);
+    void remove(Id id);
+    /** @} */
 
     /** Set of attribute names. */
     typedef std::set<std::string> AttributeIdentifiers;
@@ -403,6 +450,160 @@ private:
 
 
 
+/** Typed IR node attribute values stored outside the nodes.
+ *
+ *  An attribute table stores at most one value of type @p T per IR node. The table itself is the key: an analysis that
+ *  attaches one kind of information to many nodes declares one table for it, rather than registering an attribute name and
+ *  wrapping each value in a heap-allocated @ref AstAttribute subclass. Accessing a value is a single hash lookup of the node
+ *  pointer, with no string comparison, no virtual function call and no @c dynamic_cast.
+ *
+ *  Values are stored by value in slabs that never move, so a reference to a value remains valid until that value is erased or
+ *  the table is cleared. The slots of erased values are reused. @p T must be default constructible and copyable; values are
+ *  copied with the copy constructor, so no virtual @c copy is needed.
+ *
+ *  The table is independent of the IR nodes: copying a node does not copy its value (see @ref copyValue), deleting a node does
+ *  not erase its value, and the values are not stored in binary AST files. The table is not synchronized.
+ *
+ *  @code
+ *  static AstAttributeTable<int> depth("depth");
+ *  depth.set(node, 1 + depth.getOrElse(node->get_parent(), 0));
+ *  @endcode */
+template<class T>
+class AstAttributeTable {
+public:
+    /** Type of value stored per node. */
+    typedef T Value;
+
+private:
+    typedef boost::unordered_map<const SgNode*, size_t> Index;
+
+    std::string name_;
+    Index index_;                                       // node to slot number
+    std::deque<T> values_;                              // values by slot number
+    std::vector<const SgNode*> nodes_;                  // node by slot number, null for free slots
+    std::vector<size_t> freeSlots_;
+
+public:
+    /** Constructs an empty table.
+     *
+     *  The name is used only in diagnostics. */
+    explicit AstAttributeTable(const std::string &name = "")
+        : name_(name) {}
+
+    /** Name given to the constructor. */
+    const std::string& name() const { return name_; }
+
+    /** Number of nodes that have a value. */
+    size_t size() const { return index_.size(); }
+
+    /** Whether no node has a value. */
+    bool isEmpty() const { return index_.empty(); }
+
+    /** Whether the node has a value. */
+    bool exists(const SgNode *node) const {
+        return index_.find(node) != index_.end();
+    }
+
+    /** Value for a node, or null if the node has no value.
+     *
+     * @{ */
+    const T* get(const SgNode *node) const {
+        typename Index::const_iterator found = index_.find(node);
+        return found == index_.end() ? NULL : &values_[found->second];
+    }
+    T* get(const SgNode *node) {
+        typename Index::const_iterator found = index_.find(node);
+        return found == index_.end() ? NULL : &values_[found->second];
+    }
+    /** @} */
+
+    /** Value for a node, or the specified default if the node has no value. */
+    T getOrElse(const SgNode *node, const T &dflt) const {
+        const T *value = get(node);
+        return value ? *value : dflt;
+    }
+
+    /** Value for a node, inserting a default constructed value if the node has none. */
+    T& operator[](const SgNode *node) {
+        return values_[slotFor(node)];
+    }
+
+    /** Set the value for a node, replacing any previous value. */
+    void set(const SgNode *node, const T &value) {
+        values_[slotFor(node)] = value;
+    }
+
+    /** Erase the value for a node.
+     *
+     *  Returns true if the node had a value. */
+    bool erase(const SgNode *node) {
+        typename Index::iterator found = index_.find(node);
+        if (found == index_.end())
+            return false;
+        size_t slot = found->second;
+        index_.erase(found);
+        values_[slot] = T();
+        nodes_[slot] = NULL;
+        freeSlots_.push_back(slot);
+        return true;
+    }
+
+    /** Copy the value of one node to another.
+     *
+     *  If @p from has no value then any value for @p to is erased. This is the counterpart of @ref AstAttribute::copy for
+     *  values in a table, for use after copying part of an AST. */
+    void copyValue(const SgNode *from, const SgNode *to) {
+        if (from == to)
+            return;
+        if (const T *value = get(from)) {
+            T copy = *value;                            // the slots may grow
+            set(to, copy);
+        } else {
+            erase(to);
+        }
+    }
+
+    /** Nodes that have a value, in no particular order. */
+    std::vector<const SgNode*> nodes() const {
+        std::vector<const SgNode*> retval;
+        retval.reserve(index_.size());
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i] != NULL)
+                retval.push_back(nodes_[i]);
+        }
+        return retval;
+    }
+
+    /** Erase all values. */
+    void clear() {
+        index_.clear();
+        values_.clear();
+        nodes_.clear();
+        freeSlots_.clear();
+    }
+
+private:
+    size_t slotFor(const SgNode *node) {
+        ASSERT_not_null(node);
+        typename Index::const_iterator found = index_.find(node);
+        if (found != index_.end())
+            return found->second;
+        size_t slot;
+        if (freeSlots_.empty()) {
+            slot = values_.size();
+            values_.push_back(T());
+            nodes_.push_back(node);
+        } else {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+            nodes_[slot] = node;
+        }
+        index_.insert(std::make_pair(node, slot));
+        return slot;
+    }
+};
+
+
 /** Attribute corresponding to a metric.
  *
  *  A metric attribute represents a numeric value obtained by either dynamic analysis (gprof or hpct) or static analysis (for
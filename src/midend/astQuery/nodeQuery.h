@@ -5,6 +5,8 @@
 #include "AstProcessing.h"
 #include "astQuery.h"
 #include <functional>
+#include <map>
+#include <vector>
 #include "rosedll.h"
 
 // #include "variantVector.h"
@@ -185,7 +187,7 @@ namespace NodeQuery
 
   // Functions supporting the query of variants
   void pushNewNode ( NodeQuerySynthesizedAttributeType* nodeList, const VariantVector & targetVariantVector, SgNode * astNode);
-  void* querySolverGrammarElementFromVariantVector ( SgNode * astNode, VariantVector targetVariantVector,  NodeQuerySynthesizedAttributeType* returnNodeList );
+  void* querySolverGrammarElementFromVariantVector ( SgNode * astNode, const VariantVector & targetVariantVector,  NodeQuerySynthesizedAttributeType* returnNodeList );
   NodeQuerySynthesizedAttributeType querySolverGrammarElementFromVariantVector ( SgNode * astNode, VariantVector targetVariantVector );
 
 
@@ -344,6 +346,79 @@ namespace NodeQuery
   // DQ (3/25/2004): Added to support more general form of query based on variant value
   ROSE_DLL_API NodeQuerySynthesizedAttributeType queryNodeList ( NodeQuerySynthesizedAttributeType, VariantVector);
 
+  /**********************************************************************************************
+   * The function
+   *    querySubTree (SgNode * subTree, const std::vector<VariantVector> & targetVariantVectors,
+   *      std::vector<NodeQuerySynthesizedAttributeType> & results,
+   *      AstQueryNamespace::QueryDepth defineQueryType = AstQueryNamespace::AllNodes);
+   * answers several variant queries with a single traversal of the sub-tree of 'subTree'. On return
+   * results[i] holds the list that querySubTree(subTree,targetVariantVectors[i],defineQueryType)
+   * would return (same nodes, same order).  Use this instead of a sequence of querySubTree() calls
+   * on the same sub-tree.
+   *********************************************************************************************/
+  ROSE_DLL_API void
+  querySubTree (SgNode * subTree, const std::vector<VariantVector> & targetVariantVectors,
+                std::vector<NodeQuerySynthesizedAttributeType> & results,
+                AstQueryNamespace::QueryDepth defineQueryType = AstQueryNamespace::AllNodes);
+
+  /**********************************************************************************************
+   * The class
+   *    VariantIndex
+   * answers querySubTree(subTree,targetVariantVector) for sub-trees of an indexed AST without
+   * traversing them.  build() numbers the nodes of the AST in preorder, so that the nodes of any
+   * sub-tree have consecutive numbers; the nodes of each variant are then collected from the
+   * memory pools (the first time that variant is queried) and sorted by number.  A query is a
+   * binary search in the list of each requested variant, i.e. it costs O(log n) plus the size
+   * of the result instead of a traversal of the sub-tree.
+   *
+   * The index is a snapshot: it must be rebuilt (or invalidate()'d) when the AST is modified.
+   * isValid() detects the addition or deletion of IR nodes by recounting the memory pools,
+   * which is linear in the size of the memory pools and meant for assertions, not for every
+   * query.  Queries that the index cannot answer fall back to NodeQuery::querySubTree(): when
+   * the index is not built, when the sub-tree is not part of the indexed AST, and for variants
+   * of types, which the variant query also collects from nodes that the traversal does not visit.
+   * Unlike the traversal, the index reports a node once even if its variant occurs several times
+   * in the VariantVector.
+   *********************************************************************************************/
+  class ROSE_DLL_API VariantIndex
+     {
+       public:
+          VariantIndex();
+          explicit VariantIndex(SgNode* root);
+
+       // (Re)build the index for the AST rooted at 'root'
+          void build(SgNode* root);
+
+       // Forget the index; queries traverse the AST until the next build()
+          void invalidate();
+
+       // Whether the index is built and no IR nodes were added to or deleted from the memory pools since
+          bool isValid() const;
+
+          SgNode* get_root() const;
+
+       // Number of nodes of the indexed AST
+          size_t size() const;
+
+          NodeQuerySynthesizedAttributeType querySubTree(SgNode* subTree, const VariantVector & targetVariantVector);
+          NodeQuerySynthesizedAttributeType querySubTree(SgNode* subTree, VariantT targetVariant);
+
+       private:
+       // preorder number of a node and of its last descendant
+          typedef std::pair<size_t,size_t> NumberRange;
+          typedef std::pair<size_t,SgNode*> NumberedNode;
+
+          const std::vector<NumberedNode> & nodesOfVariant(VariantT variant);
+
+          SgNode* root;
+          size_t numberOfNodesInMemoryPools;
+          std::map<SgNode*,NumberRange> numbers;
+
+       // indexed by VariantT, filled on first use
+          std::vector<std::vector<NumberedNode> > variantNodes;
+          std::vector<bool> variantIsIndexed;
+     };
+
   void
   mergeList (Rose_STL_Container<SgNode*> & nodeList, const Rose_STL_Container<SgNode*> & localList);
 
@@ -43,6 +43,10 @@ namespace PartialSymbolicSemantics {
 
     extern uint64_t name_counter;
 
+    /** Returns a new unique name for an unknown value.  Threads that run semantics concurrently (e.g., the threaded test
+     *  executor of the clone detection project) create values at the same time, so the counter is incremented atomically. */
+    uint64_t next_name();
+
     /** A value is either known or unknown. Unknown values have a base name (unique ID number), offset, and sign. */
     template<size_t nBits>
     struct ValueType {
@@ -53,7 +57,7 @@ namespace PartialSymbolicSemantics {
                                              *    constants. */
 
         /** Construct a value that is unknown and unique. */
-        ValueType(): name(++name_counter), offset(0), negate(false) {}
+        ValueType(): name(next_name()), offset(0), negate(false) {}
 
         /** Copy-construct a value, truncating or extending at msb the source value. */
         template <size_t Len>
@@ -15,6 +15,7 @@
 #include <queue>
 #include <boost/foreach.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/function.hpp>
 
 class FunctionData;
 
@@ -126,20 +127,63 @@ class ROSE_DLL_API CallGraphBuilder
     //! Builder accepting user defined predicate to filter certain functions
     template<typename Predicate>
       void buildCallGraph(Predicate pred);
+    //! Recompute the outgoing edges of functions modified since the last build, leaving all other edges alone.  Use this
+    //! instead of rebuilding the whole graph after transformations that only change the bodies of a few functions (e.g.
+    //! inlining).  Modified functions not yet in the graph (e.g. created by outlining) are added to it; callees new to
+    //! the graph are added as nodes.  Deleting a function still requires a full buildCallGraph().  Uses the predicate of
+    //! the last buildCallGraph() call.
+    void updateCallGraph(const std::vector<SgFunctionDeclaration*> &modifiedFunctions);
     //! Grab the call graph built
     SgIncidenceDirectedGraph *getGraph(); 
     //void classifyCallGraph();
 
+    //! Number of threads used to find the call sites of each function and resolve the direct calls among them (default
+    //! 1). Calls through pointers, virtual calls and constructor calls are resolved serially afterwards, since their
+    //! resolution queries ROSE's global type and name tables.
+    void setNumberOfThreads(size_t n) { nThreads = n > 0 ? n : 1; }
+    size_t getNumberOfThreads() const { return nThreads; }
+
     //We map each function to the corresponding graph node
     boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*>& getGraphNodesMapping(){ return graphNodes; }
 
+    //! @{
+    //! Compact view of the graph built: functions are numbered densely and the callees of function @p i are
+    //! @c getCallee(i,0) .. @c getCallee(i,getNumberOfCallees(i)-1), without duplicates, in call site order.
+    size_t getNumberOfFunctions() const { return functions.size(); }
+    SgFunctionDeclaration* getFunction(size_t i) const { return functions[i]; }
+    size_t getNumberOfCallees(size_t i) const { return calleeOffsets[i+1] - calleeOffsets[i]; }
+    size_t getCallee(size_t i, size_t j) const { return callees[calleeOffsets[i] + j]; }
+    //! @}
+
   private:
+    typedef boost::function<bool(SgFunctionDeclaration*)> FunctionPredicate;
+
+    // Non-template part of buildCallGraph()
+    void buildCallGraphForPredicate(const FunctionPredicate &pred);
+
+    // True if the function should be part of the graph
+    bool isSelected(SgFunctionDeclaration *f) const;
+
+    // Index of a function in the compact graph, adding a node for it if it isn't there yet
+    size_t findOrAddFunction(SgFunctionDeclaration *unique);
+
+    // Computes the selected callees of each of the given functions, without duplicates and in call site order
+    void findCallees(const std::vector<SgFunctionDeclaration*> &callers, ClassHierarchyWrapper *classHierarchy,
+                     std::vector<std::vector<SgFunctionDeclaration*> > &result) const;
+
     SgProject *project;
     SgIncidenceDirectedGraph *graph;
     //We map each function to the corresponding graph node
     typedef boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*> GraphNodes;
     GraphNodes graphNodes;
 
+    FunctionPredicate predicate;
+    size_t nThreads;
+
+    std::vector<SgFunctionDeclaration*> functions;              // index -> unique (first nondefining) declaration
+    boost::unordered_map<SgFunctionDeclaration*, size_t> functionIndices;
+    std::vector<size_t> calleeOffsets;                          // callees of function i are callees[calleeOffsets[i]] ..
+    std::vector<size_t> callees;                                //   callees[calleeOffsets[i+1]-1], as function indices
 };
 //! Generate a dot graph named 'fileName' from a call graph 
 //TODO this function is    not defined? If so, need to be removed. 
@@ -156,57 +200,7 @@ template<typename Predicate>
 void
 CallGraphBuilder::buildCallGraph(Predicate pred)
 {
-    // Adds additional constraints to the predicate. It makes no sense to analyze non-instantiated templates.
-    struct isSelected {
-        Predicate &pred;
-        isSelected(Predicate &pred): pred(pred) {}
-        bool operator()(SgNode *node) {
-            SgFunctionDeclaration *f = isSgFunctionDeclaration(node);
-            assert(!f || f==f->get_firstNondefiningDeclaration()); // node uniqueness test
-            if(isSgTemplateFunctionDeclaration(f)||isSgTemplateMemberFunctionDeclaration(f)) {
-              std::cerr<<"Error: CallGraphBuilder: call referring to node "<<f->class_name()<<" :: function-name:"<<f->get_qualified_name()<<std::endl;
-            }
-            return f && !isSgTemplateMemberFunctionDeclaration(f) && !isSgTemplateFunctionDeclaration(f) && pred(f);
-        }
-    };
-
-    // Add nodes to the graph by querying the memory pool for function declarations, mapping them to unique declarations
-    // that can be used as keys in a map (using get_firstNondefiningDeclaration()), and filtering according to the predicate.
-    graph = new SgIncidenceDirectedGraph();
-    std::vector<FunctionData> callGraphData;
-    ClassHierarchyWrapper classHierarchy(project);
-    graphNodes.clear();
-    VariantVector vv(V_SgFunctionDeclaration);
-    GetOneFuncDeclarationPerFunction defFunc;
-    std::vector<SgNode*> fdecl_nodes = NodeQuery::queryMemoryPool(defFunc, &vv);
-    BOOST_FOREACH(SgNode *node, fdecl_nodes) {
-        SgFunctionDeclaration *fdecl = isSgFunctionDeclaration(node);
-        SgFunctionDeclaration *unique = isSgFunctionDeclaration(fdecl->get_firstNondefiningDeclaration());
-        if (isSelected(pred)(unique) && graphNodes.find(unique)==graphNodes.end()) {
-            FunctionData fdata(unique, project, &classHierarchy); // computes functions called by unique
-            callGraphData.push_back(fdata);
-            std::string functionName = unique->get_qualified_name().getString();
-            SgGraphNode *graphNode = new SgGraphNode(functionName);
-            graphNode->set_SgNode(unique);
-            graphNodes[unique] = graphNode;
-            graph->addNode(graphNode);
-        }
-    }
-
-    // Add edges to the graph
-    BOOST_FOREACH(FunctionData &currentFunction, callGraphData) {
-        SgGraphNode *srcNode = graphNodes.find(currentFunction.functionDeclaration)->second; // we inserted it above
-        std::vector<SgFunctionDeclaration*> &callees = currentFunction.functionList;
-        BOOST_FOREACH(SgFunctionDeclaration *callee, callees) {
-            if (isSelected(pred)(callee)) {
-                GraphNodes::iterator dstNodeFound = graphNodes.find(callee);
-                assert(dstNodeFound!=graphNodes.end()); // should have been added above
-                SgGraphNode *dstNode = dstNodeFound->second;
-                if (graph->checkIfDirectedGraphEdgeExists(srcNode, dstNode) == false)
-                    graph->addDirectedEdge(srcNode, dstNode);
-            }
-        }
-    }
+    buildCallGraphForPredicate(FunctionPredicate(pred));
 }
 
 // endif for CALL_GRAPH_H
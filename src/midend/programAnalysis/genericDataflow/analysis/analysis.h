@@ -26,7 +26,17 @@ class Analysis
     // Custom filter is set inside the intra-procedural analysis.
     // Inter-procedural analysis will copy the filter from its intra-procedural analysis during the call to its constructor.
     bool (*filter) (CFGNode cfgn); 
-    Analysis(bool (*f)(CFGNode) = defaultFilter):filter(f) {}
+    Analysis(bool (*f)(CFGNode) = defaultFilter):filter(f), stateIndex(-1) {}
+    Analysis(const Analysis& that):filter(that.filter), stateIndex(-1) {}
+    Analysis& operator=(const Analysis& that) { filter = that.filter; return *this; }
+    ~Analysis();
+
+  private:
+    friend class NodeState;
+    // The index under which NodeState keeps this analysis' lattices and facts, or -1 until it keeps any
+    // (copies get their own). NodeState hands out the indices densely and reuses the index of a destroyed
+    // analysis, so they stay small however many Analysis objects a run creates.
+    mutable int stateIndex;
 };
 
 class InterProceduralAnalysis;
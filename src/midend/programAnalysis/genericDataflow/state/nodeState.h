@@ -11,6 +11,7 @@ class NodeState;
 #include <vector>
 #include <string>
 #include <set>
+#include <boost/unordered_map.hpp>
 
 #ifdef THREADED
 #include "tbb/concurrent_hash_map.h"
@@ -86,18 +87,90 @@ class NodeStateHashCompare
 };
 #endif
 
+#ifndef THREADED
+// The state of one kind (the lattices above or below a node, its facts, or whether an analysis has
+// initialized its state there) that the analyses keep at all NodeStates. Every analysis that keeps state
+// has a dense analysis index and every NodeState a dense node index (both handed out by NodeState), and
+// each analysis' state is kept in its own array indexed by node index. The arrays are allocated in chunks
+// that never move, so references to an entry stay valid when other nodes or analyses add state, as they
+// would be in a std::map (DFStateAtReturns keeps such references).
+template<class T>
+class AnalysisStateTable
+{
+        public:
+        // first is the analysis that owns the state, or NULL if there is no state at the node
+        typedef std::pair<Analysis*, T> value_type;
+        
+        private:
+        static const size_t chunkSize = 256;
+        // chunks[analysisIndex][nodeIndex/chunkSize], NULL where no node in the chunk has state
+        std::vector<std::vector<value_type*> > chunks;
+        
+        public:
+        // returns the entry of the given analysis at the given node, or NULL if it has not been allocated
+        value_type* find(int analysisIndex, size_t nodeIndex) const;
+        // returns the entry of the given analysis at the given node, allocating it if needed
+        value_type& get(int analysisIndex, size_t nodeIndex);
+        // the number of analysis indices that have had state in this table
+        size_t numAnalyses() const { return chunks.size(); }
+        // removes the state of all analyses at the given node
+        void clearNode(size_t nodeIndex);
+        // frees all the state of the given analysis
+        void clearAnalysis(int analysisIndex);
+};
+
+// The entries of an AnalysisStateTable at one NodeState, with the subset of the std::map interface
+// that NodeState uses.
+template<class T>
+class AnalysisStateMap
+{
+        public:
+        typedef typename AnalysisStateTable<T>::value_type value_type;
+        typedef value_type* iterator;
+        typedef const value_type* const_iterator;
+        
+        private:
+        AnalysisStateTable<T>* table;
+        size_t nodeIndex;
+        
+        // the entries belong to the NodeState, use assign() to copy them
+        AnalysisStateMap(const AnalysisStateMap& that);
+        AnalysisStateMap& operator=(const AnalysisStateMap& that);
+        
+        public:
+        AnalysisStateMap(AnalysisStateTable<T>& table, size_t nodeIndex) : table(&table), nodeIndex(nodeIndex) {}
+        
+        // replaces the entries of this map by copies of the entries of that
+        void assign(const AnalysisStateMap& that);
+        
+        iterator find(Analysis* analysis);
+        const_iterator find(Analysis* analysis) const;
+        iterator end() { return NULL; }
+        const_iterator end() const { return NULL; }
+        T& operator[](Analysis* analysis);
+        void erase(Analysis* analysis);
+        size_t size() const;
+        void clear();
+};
+#endif
+
 class NodeState
 {
+        template<class T> friend class AnalysisStateMap;
+        
         #ifdef THREADED
         typedef tbb::concurrent_hash_map <Analysis*, std::vector<Lattice*>, NodeStateHashCompare > LatticeMap;
         //typedef tbb::concurrent_hash_map <Analysis*, map <int, NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, std::vector<NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, bool, NodeStateHashCompare  > BoolMap;     
         #else
-        typedef std::map<Analysis*, std::vector<Lattice*> > LatticeMap;
+        typedef AnalysisStateMap<std::vector<Lattice*> > LatticeMap;
         //typedef std::map<Analysis*, std::map<int, NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, std::vector<NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, bool > BoolMap;
+        typedef AnalysisStateMap<std::vector<NodeFact*> > NodeFactMap;
+        typedef AnalysisStateMap<bool> BoolMap;
+        
+        // the index of this NodeState in the AnalysisStateTables
+        size_t nodeIndex;
         #endif
         
         // the dataflow information Above the node, for each analysis that 
@@ -129,8 +202,12 @@ class NodeState
         NodeState(CFGNode parentNode) : parentNode(parentNode)
         {}*/
         
-        NodeState()
-        {}
+        NodeState();
+        #ifndef THREADED
+        NodeState(const NodeState& that);
+        NodeState& operator=(const NodeState& that);
+        ~NodeState();
+        #endif
         
 /*      void initialize(Analysis* analysis, int latticeName)
         {
@@ -284,7 +361,42 @@ class NodeState
         
         // ====== STATIC ======
         private:
-        static std::map<DataflowNode, std::vector<NodeState*> > nodeStateMap;
+        #ifndef THREADED
+        static AnalysisStateTable<std::vector<Lattice*> > dfInfoAboveTable;
+        static AnalysisStateTable<std::vector<Lattice*> > dfInfoBelowTable;
+        static AnalysisStateTable<std::vector<NodeFact*> > factsTable;
+        static AnalysisStateTable<bool> initializedAnalysesTable;
+        
+        // node indices of destroyed NodeStates, which are reused before new ones are handed out
+        static std::vector<size_t> freeNodeIndices;
+        static size_t numNodeIndices;
+        static size_t allocateNodeIndex();
+        
+        // analysis indices of destroyed analyses, which are reused before new ones are handed out
+        static std::vector<int> freeAnalysisIndices;
+        static int numAnalysisIndices;
+        #endif
+        
+        // returns the analysis index of the given analysis, or -1 if it keeps no state at any NodeState
+        static int findAnalysisIndex(const Analysis* analysis);
+        // returns the analysis index of the given analysis, handing one out if it has none yet
+        static int getAnalysisIndex(const Analysis* analysis);
+        
+        public:
+        // frees all the state that the given analysis keeps at NodeStates and its analysis index;
+        // called when the analysis is destroyed
+        static void releaseAnalysis(const Analysis* analysis);
+        
+        private:
+        struct DataflowNodeHash
+        {
+                size_t operator()(const DataflowNode& n) const
+                { return ((size_t)n.getNode() >> 3) ^ ((size_t)n.getIndex() * 0x9e3779b9u); }
+        };
+        
+        // All NodeStates are allocated in one array by initNodeStateMap() and looked up by hashing
+        // the dataflow node.
+        static boost::unordered_map<DataflowNode, std::vector<NodeState*>, DataflowNodeHash> nodeStateMap;
         static bool nodeStateMapInit;
         
         public:
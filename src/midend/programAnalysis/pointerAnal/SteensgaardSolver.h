@@ -0,0 +1,177 @@
+#ifndef STEENSGAARD_SOLVER_H
+#define STEENSGAARD_SOLVER_H
+
+#include <boost/unordered_map.hpp>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+// Steensgaard's analysis with constraint generation separated from solving.
+//
+// SteensgaardConstraints records the constraints of ECRmap (steensgaard.h) in
+// a flat array, naming variables by dense integer IDs.  A buffer holds no
+// analysis state, so the constraints of each function can be collected
+// independently and the buffers merged with append().
+//
+// SteensgaardSolver solves a buffer using array-based union-find (union by
+// size, path compression) over dense ECR IDs.  It makes the same unifications
+// in the same order as ECRmap, so mayAlias() and output() give identical
+// results, but it allocates no per-ECR objects and a query costs two finds.
+
+class SteensgaardConstraints
+{
+ public:
+   typedef unsigned VarId;
+   static const VarId NO_VAR = (VarId)(-1);   // ID of the empty name ""
+
+   typedef enum { X_EQ_Y, X_EQ_ADDR_Y, X_EQ_DEREF_Y, X_EQ_OP_Y, ALLOCATE,
+                  DEREF_X_EQ_Y, FUNCTION_DEF, FUNCTION_CALL } Kind;
+   struct Constraint {
+      Kind kind;
+      VarId x, y;
+      // Operand lists in get_args(): the operands of X_EQ_OP_Y (nIn), the
+      // parameters (nIn) and outputs (nOut) of FUNCTION_DEF, and the
+      // arguments (nIn) and results (nOut) of FUNCTION_CALL
+      unsigned args, nIn, nOut;
+   };
+
+   // Same constraints and argument order as ECRmap
+   void x_eq_y(const std::string& x, const std::string& y) { add(X_EQ_Y, x, y); }
+   void x_eq_addr_y(const std::string& x, const std::string& y) { add(X_EQ_ADDR_Y, x, y); }
+   void x_eq_deref_y(const std::string& x, const std::string& y) { add(X_EQ_DEREF_Y, x, y); }
+   void x_eq_op_y(const std::string& x, const std::list<std::string>& y);
+   void allocate(const std::string& x) { add(ALLOCATE, x, ""); }
+   void deref_x_eq_y(const std::string& x, const std::string& y) { add(DEREF_X_EQ_Y, x, y); }
+   void function_def_x(const std::string& x, const std::list<std::string>& inParams,
+                       const std::list<std::string>& outParams);
+   void function_call_p(const std::string& p, const std::list<std::string>& x,
+                        const std::list<std::string>& y);
+
+   // Append the constraints of another buffer, renaming its variables
+   void append(const SteensgaardConstraints& that);
+
+   // ID of a variable, adding it if necessary
+   VarId get_var(const std::string& name);
+   // ID of a variable, or NO_VAR if it does not occur in any constraint
+   VarId find_var(const std::string& name) const;
+   const std::string& get_name(VarId v) const { return names[v]; }
+   size_t num_vars() const { return names.size(); }
+
+   size_t size() const { return constraints.size(); }
+   const Constraint& operator[](size_t i) const { return constraints[i]; }
+   const VarId* get_args(const Constraint& c) const
+      { return args.empty() ? 0 : &args[0] + c.args; }
+
+   // Replay the constraints [first, size()) into anything with ECRmap's
+   // interface, e.g., to compare against ECRmap itself
+   template <class Target> void apply(Target& target, size_t first = 0) const;
+
+ private:
+   std::vector<std::string> names;
+   boost::unordered_map<std::string, VarId> ids;
+   std::vector<Constraint> constraints;
+   std::vector<VarId> args;
+
+   void add(Kind kind, const std::string& x, const std::string& y);
+   void add_list(const std::list<std::string>& vars);
+   std::list<std::string> get_list(const VarId* vars, unsigned n) const;
+};
+
+class SteensgaardSolver
+{
+ public:
+   typedef SteensgaardConstraints::VarId VarId;
+   typedef unsigned EcrId;
+   static const EcrId NO_ECR = (EcrId)(-1);
+
+   // Constraints added to the buffer later are picked up by the next solve()
+   SteensgaardSolver(const SteensgaardConstraints& c) : constraints(c), nSolved(0) {}
+
+   // Process the constraints added since the last call
+   void solve();
+
+   // Whether x and y may point to the same location; solves first
+   bool mayAlias(VarId x, VarId y);
+   bool mayAlias(const std::string& x, const std::string& y);
+   // Representative ECR of the locations x may point to, or NO_ECR if x is
+   // unknown.  Two variables may alias iff they have the same points-to ECR.
+   EcrId get_pointsTo(VarId x);
+
+   size_t num_ecrs() const { return parent.size(); }
+
+   void output(std::ostream& out);
+   void dump() { output(std::cerr); }
+
+ private:
+   static const unsigned NO_LAMBDA = (unsigned)(-1);
+   static const unsigned NO_LINK = (unsigned)(-1);
+
+   const SteensgaardConstraints& constraints;
+   size_t nSolved;
+
+   // Per ECR; type, pendingHead and pendingTail are meaningful at roots only,
+   // while lambda is read from whichever ECR it was attached to, as in ECRmap
+   std::vector<EcrId> parent;
+   std::vector<unsigned> ecrSize;
+   std::vector<EcrId> type;
+   std::vector<unsigned> lambda;
+   std::vector<unsigned> pendingHead, pendingTail;
+
+   struct PendingLink { EcrId ecr; unsigned next; };
+   std::vector<PendingLink> pendingLinks;
+
+   struct Lambda { unsigned in, nIn, out, nOut; };
+   std::vector<Lambda> lambdas;
+   std::vector<EcrId> lambdaParams;
+
+   std::vector<EcrId> varEcr;   // VarId -> ECR, or NO_ECR
+
+   EcrId find(EcrId e);
+   EcrId new_ECR();
+   EcrId get_ECR(VarId x);
+   EcrId get_type(EcrId e) { EcrId g = find(e); return type[g] == NO_ECR ? NO_ECR : find(type[g]); }
+   EcrId union_with(EcrId e1, EcrId e2);
+
+   void pending_push(EcrId owner, EcrId e);
+   void pending_append(EcrId owner, EcrId from);
+   void pending_get(EcrId owner, std::vector<EcrId>& result) const;
+   void pending_clear(EcrId owner) { pendingHead[owner] = pendingTail[owner] = NO_LINK; }
+
+   unsigned new_Lambda(const VarId* inParams, unsigned nIn, const VarId* outParams, unsigned nOut);
+   void set_type(EcrId e, EcrId t);
+   void cjoin(EcrId e1, EcrId e2);
+   void unify_lambda(unsigned l1, unsigned l2);
+   void unify(EcrId t1, EcrId t2);
+   void join(EcrId e1, EcrId e2);
+
+   void apply(const SteensgaardConstraints::Constraint& c);
+
+   int find_LOC(boost::unordered_map<EcrId, int>& locmap, int& loc, EcrId p);
+   void outputLOC(std::ostream& out, boost::unordered_map<EcrId, int>& locmap, int& loc, EcrId p);
+};
+
+template <class Target>
+void SteensgaardConstraints::apply(Target& target, size_t first) const
+{
+   for (size_t i = first; i < constraints.size(); ++i) {
+      const Constraint& c = constraints[i];
+      const VarId* a = get_args(c);
+      switch (c.kind) {
+      case X_EQ_Y: target.x_eq_y(names[c.x], names[c.y]); break;
+      case X_EQ_ADDR_Y: target.x_eq_addr_y(names[c.x], names[c.y]); break;
+      case X_EQ_DEREF_Y: target.x_eq_deref_y(names[c.x], names[c.y]); break;
+      case X_EQ_OP_Y: target.x_eq_op_y(names[c.x], get_list(a, c.nIn)); break;
+      case ALLOCATE: target.allocate(names[c.x]); break;
+      case DEREF_X_EQ_Y: target.deref_x_eq_y(names[c.x], names[c.y]); break;
+      case FUNCTION_DEF:
+         target.function_def_x(names[c.x], get_list(a, c.nIn), get_list(a + c.nIn, c.nOut));
+         break;
+      case FUNCTION_CALL:
+         target.function_call_p(names[c.x], get_list(a + c.nIn, c.nOut), get_list(a, c.nIn));
+         break;
+      }
+   }
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <map>
 #include <iterator>
 #include <boost/foreach.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/topological_sort.hpp>
 
@@ -56,6 +57,124 @@ namespace ssa_private
         return result;
     }
 
+    /** Dense form of the dominance frontiers of a function, for computing the iterated dominance frontiers of many
+     * variables. Each CFG node gets an index (in the order of the dominance frontier map, so sorting indices sorts
+     * nodes), the frontiers are stored as one flat array, and the visited/result sets are word-packed bit vectors
+     * that are cleared incrementally, so one query costs time proportional to the frontier edges it scans rather
+     * than to the size of the function.
+     *
+     * calculate() uses exactly the same worklist order as calculateIteratedDominanceFrontier, so both return the same
+     * set of nodes for the same start nodes. */
+    template<class CfgNodeT>
+    class DominanceFrontierIndex
+    {
+    public:
+
+        DominanceFrontierIndex(const map<CfgNodeT, set<CfgNodeT> >& dominanceFrontiers)
+        {
+            typedef typename map<CfgNodeT, set<CfgNodeT> >::const_iterator FrontierIter;
+
+            nodes.reserve(dominanceFrontiers.size());
+            for (FrontierIter i = dominanceFrontiers.begin(); i != dominanceFrontiers.end(); ++i)
+            {
+                nodeIndices.insert(nodeIndices.end(), make_pair(i->first, nodes.size()));
+                nodes.push_back(i->first);
+            }
+
+            frontierOffsets.reserve(nodes.size() + 1);
+            frontierOffsets.push_back(0);
+            for (FrontierIter i = dominanceFrontiers.begin(); i != dominanceFrontiers.end(); ++i)
+            {
+                BOOST_FOREACH(const CfgNodeT& dfNode, i->second)
+                {
+                    frontiers.push_back(getIndex(dfNode));
+                }
+                frontierOffsets.push_back(frontiers.size());
+            }
+
+            visited.resize(nodes.size());
+            inResult.resize(nodes.size());
+        }
+
+        /** Number of CFG nodes in the index. */
+        size_t size() const
+        {
+            return nodes.size();
+        }
+
+        /** Index of a CFG node, which must have a dominance frontier entry. */
+        size_t getIndex(const CfgNodeT& node) const
+        {
+            typename map<CfgNodeT, size_t>::const_iterator i = nodeIndices.find(node);
+            ROSE_ASSERT(i != nodeIndices.end());
+            return i->second;
+        }
+
+        /** CFG node with the given index. */
+        const CfgNodeT& getNode(size_t index) const
+        {
+            return nodes[index];
+        }
+
+        /** Appends the iterated dominance frontier of the given start nodes to result, as node indices in discovery
+         * order. */
+        void calculate(const vector<size_t>& startNodes, vector<size_t>& result)
+        {
+            size_t resultBegin = result.size();
+            worklist.assign(startNodes.begin(), startNodes.end());
+            touched.clear();
+
+            while (!worklist.empty())
+            {
+                size_t currentNode = worklist.back();
+                worklist.pop_back();
+                if (!visited.test(currentNode))
+                {
+                    visited.set(currentNode);
+                    touched.push_back(currentNode);
+                }
+
+                for (size_t i = frontierOffsets[currentNode]; i < frontierOffsets[currentNode + 1]; i++)
+                {
+                    size_t dfNode = frontiers[i];
+                    if (visited.test(dfNode))
+                        continue;
+
+                    if (!inResult.test(dfNode))
+                    {
+                        inResult.set(dfNode);
+                        result.push_back(dfNode);
+                    }
+                    worklist.push_back(dfNode);
+                }
+            }
+
+            //Clear only the bits we set, so the next query doesn't pay for the whole function
+            BOOST_FOREACH(size_t node, touched)
+            {
+                visited.reset(node);
+            }
+            for (size_t i = resultBegin; i < result.size(); i++)
+            {
+                inResult.reset(result[i]);
+            }
+        }
+
+    private:
+        vector<CfgNodeT> nodes;
+        map<CfgNodeT, size_t> nodeIndices;
+
+        /** The dominance frontier of node i is frontiers[frontierOffsets[i] .. frontierOffsets[i+1]). */
+        vector<size_t> frontierOffsets;
+        vector<size_t> frontiers;
+
+        //Scratch space reused by calculate()
+        boost::dynamic_bitset<> visited;
+        boost::dynamic_bitset<> inResult;
+        vector<size_t> worklist;
+        vector<size_t> touched;
+    };
+
     /** Calculates the dominance frontier for each node in the control flow graph of the given function.
      * @param iDominatorMap map from each node to its immediate dominator
      * @param iPostDominatorMap map from each node to its immediate postdominator */
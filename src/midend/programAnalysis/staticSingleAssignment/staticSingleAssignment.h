@@ -19,6 +19,8 @@
 #include <boost/foreach.hpp>
 #include <filteredCFG.h>
 #include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include "reachingDef.h"
 #include "dataflowCfgFilter.h"
 #include "CallGraph.h"
@@ -130,6 +132,40 @@ private:
      * the values here cannot be used during interprocedural analysis.  */
     boost::unordered_map<SgNode*, NodeReachingDefTable> ssaLocalDefTable;
 
+    /** Dense identifier of a variable name, see getVarId(). */
+    typedef unsigned int VarId;
+
+    /** Every variable name seen by the analysis, interned to a dense identifier so that per-variable bookkeeping
+     * (phi placement, renumbering, def-use dataflow) can use vectors, bit vectors and cheap hashes instead of ordered
+     * maps keyed by whole names. */
+    boost::unordered_map<VarName, VarId> varIds;
+
+    /** A set of reaching definitions in the def-use dataflow. The variables are the bits set in a bit vector indexed
+     * by the variable slots of the function (see DefUseDataFlow); defs holds their definitions in slot order. */
+    struct DenseReachingDefs
+    {
+        boost::dynamic_bitset<> vars;
+        std::vector<ReachingDefPtr> defs;
+
+        bool operator==(const DenseReachingDefs& other) const
+        {
+            return vars == other.vars && defs == other.defs;
+        }
+    };
+
+    /** State of runDefUseDataFlow() for one function. The variables defined in the function get dense slots, and the
+     * AST nodes dense indices in the order the dataflow reaches them. The IN, OUT and local definitions of each node
+     * are DenseReachingDefs, and whether a variable is visible at a node is cached in two bit vectors per node. */
+    struct DefUseDataFlow
+    {
+        boost::unordered_map<VarId, size_t> varSlots;
+        std::vector<const VarName*> slotVars;
+        boost::unordered_map<SgNode*, size_t> nodeIndices;
+        std::vector<SgNode*> nodes;
+        std::vector<DenseReachingDefs> incomingDefs, outgoingDefs, localDefs;
+        std::vector<boost::dynamic_bitset<> > visibilityKnown, visible;
+    };
+
 public:
 
     StaticSingleAssignment(SgProject* proj) : project(proj)
@@ -158,12 +194,30 @@ public:
 
 private:
     /** Once all the local definitions have been inserted in the ssaLocalDefsTable and phi functions have been inserted
-     * in the reaching defs table, propagate reaching definitions along the CFG. */
-    void runDefUseDataFlow(SgFunctionDefinition* func);
+     * in the reaching defs table, propagate reaching definitions along the CFG. The dataflow runs on DenseReachingDefs;
+     * the reaching defs table is updated from them at the end.
+     * @param cfgNodesInPostOrder all the CFG nodes of the function */
+    void runDefUseDataFlow(SgFunctionDefinition* func, const std::vector<FilteredCfgNode>& cfgNodesInPostOrder);
 
     /** Returns true if the variable is implicitly defined at the function entry by the compiler. */
     static bool isBuiltinVar(const VarName& var);
 
+    /** Returns the dense identifier of a variable name, assigning the next free one if the name hasn't been seen. */
+    VarId getVarId(const VarName& var);
+
+    /** Returns the dataflow index of an AST node, adding the node with its phi functions and local definitions if
+     * the dataflow hasn't reached it before. */
+    size_t getDataFlowNode(DefUseDataFlow& dataFlow, SgNode* astNode);
+
+    /** Converts a table of reaching definitions to the dense form of the dataflow. */
+    void toDenseReachingDefs(const DefUseDataFlow& dataFlow, const NodeReachingDefTable& table,
+            DenseReachingDefs& denseDefs);
+
+    /** Returns true if reaching definitions of the variable in the slot should propagate into the node with the given
+     * dataflow index, i.e. the variable is in scope there or is a built-in variable. The dataflow asks this for every
+     * variable along every CFG edge, so the answers are cached. */
+    bool isVarVisibleAt(DefUseDataFlow& dataFlow, size_t slot, size_t nodeIndex);
+
     /** Expand all member definitions (chained names) to define every name in the chain
      * that is shorter than the originally defined name.
      *
@@ -225,11 +279,11 @@ private:
 
     /** Take all the outgoing defs from previous nodes and merge them as the incoming defs
      * of the current node. */
-    void updateIncomingPropagatedDefs(FilteredCfgNode cfgNode);
+    void updateIncomingPropagatedDefs(DefUseDataFlow& dataFlow, FilteredCfgNode cfgNode, size_t nodeIndex);
 
-    /** Performs the data-flow update for one individual node, populating the reachingDefsTable for that node.
+    /** Performs the data-flow update for one individual node, populating the dense IN and OUT defs of that node.
      * @returns true if the OUT defs from the node changed, false if they stayed the same. */
-    bool propagateDefs(FilteredCfgNode cfgNode);
+    bool propagateDefs(DefUseDataFlow& dataFlow, FilteredCfgNode cfgNode);
 
     /** Once all the reaching def information has been propagated, uses the reaching def information and the local
      * use information to match uses to their reaching defs. 
@@ -21,4 +21,11 @@
 //! what can be inlined are bugs in the inliner code.
 ROSE_DLL_API bool doInline(SgFunctionCallExp* funcall, bool allowRecursion = false);
 
+//! Inlines a batch of function calls, such as all the call sites of a file, and returns the number of calls that were
+//! inlined.  Each call is inlined as by the single-call doInline() above, and a call that cannot be inlined is left in
+//! place.  The consistency fixups that traverse the whole function containing a call run once for each such function after
+//! all calls have been inlined, instead of once per call.  A call in the batch may be an argument of another call in the
+//! batch; the calls are inlined in the order given.
+ROSE_DLL_API size_t doInline(const std::vector<SgFunctionCallExp*> &funcalls, bool allowRecursion = false);
+
 #endif // INLINER_H
@@ -13,6 +13,7 @@
 #include "NameGenerator.hh"
 #include "Outliner.hh"
 #include "Preprocess.hh"
+#include "astPostProcessing.h"
 //#include "Transform.hh"
 #include "commandline_processing.h"
 #include "boost/filesystem.hpp"
@@ -167,6 +168,61 @@ Outliner::outline (SgStatement* s, const std::string& func_name)
   }  
 }
 
+std::vector<Outliner::Result>
+Outliner::outline (const std::vector<SgStatement*>& stmts)
+{
+  // Preprocessing or outlining a target copies and moves it, so no target may be inside another one
+  std::set<SgStatement*> targets (stmts.begin (), stmts.end ());
+  ROSE_ASSERT (targets.size () == stmts.size ());
+  for (size_t i = 0; i < stmts.size (); ++i)
+  {
+    ROSE_ASSERT (stmts[i] != NULL);
+    for (SgNode* p = stmts[i]->get_parent (); p != NULL; p = p->get_parent ())
+      if (isSgStatement (p) && targets.find (isSgStatement (p)) != targets.end ())
+      {
+        cerr<<"Outliner::outline() Input statement:"<<stmts[i]->unparseToString()<<"\n is inside another statement of the batch!"<<endl;
+        ROSE_ASSERT (false);
+      }
+  }
+
+  // Name, preprocess and analyze all targets before the first one is transformed
+  std::vector<std::string> func_names;
+  std::vector<SgBasicBlock*> blocks;
+  for (size_t i = 0; i < stmts.size (); ++i)
+  {
+    func_names.push_back (generateFuncName (stmts[i]));
+    blocks.push_back (preprocess (stmts[i]));
+  }
+
+  std::vector<Result> results (stmts.size ());
+  if (preproc_only_)
+    return results;
+
+  std::vector<BlockAnalysis> analyses (blocks.size ());
+  for (size_t i = 0; i < blocks.size (); ++i)
+    analyzeBlock (blocks[i], analyses[i]);
+
+  // Outline the targets, then post-process each modified file once
+  std::vector<SgSourceFile*> files;
+  std::set<SgSourceFile*> seen_files;
+  for (size_t i = 0; i < blocks.size (); ++i)
+  {
+    results[i] = outlineBlock (blocks[i], func_names[i], analyses[i], false);
+    ROSE_ASSERT (results[i].isValid ());
+
+    SgSourceFile* file = TransformationSupport::getSourceFile (results[i].call_);
+    if (seen_files.insert (file).second)
+      files.push_back (file);
+    if (results[i].file_ != NULL && seen_files.insert (isSgSourceFile (results[i].file_)).second)
+      files.push_back (isSgSourceFile (results[i].file_));
+  }
+
+  for (size_t i = 0; i < files.size (); ++i)
+    AstPostProcessing (files[i]);
+
+  return results;
+}
+
 //! Set internal options based on command line options
 void Outliner::commandLineProcessing(std::vector<std::string> &argvList)
 {
@@ -351,7 +407,7 @@ Outliner::preprocess (SgStatement* s)
  */
 
 Outliner::Result::Result (void)
-  : decl_ (0), call_ (0)
+  : decl_ (0), call_ (0), file_ (0)
 {
 }
 
@@ -362,7 +418,7 @@ Outliner::Result::Result (SgFunctionDeclaration* decl,
 }
 
 Outliner::Result::Result (const Result& b)
-  : decl_ (b.decl_), call_ (b.call_)
+  : decl_ (b.decl_), call_ (b.call_), file_ (b.file_)
 {
 }
 
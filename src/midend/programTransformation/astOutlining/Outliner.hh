@@ -147,6 +147,20 @@ namespace Outliner
   //! Outline to a new function with the specified name, calling preprocessing internally
   Result outline (SgStatement* s, const std::string& func_name);
 
+  //! Outlines a batch of statements, such as all the loop nests of a file.
+  /*!
+   *  The result is the same as calling outline(SgStatement*) on each
+   *  statement in order, and the i-th result belongs to stmts[i]. All
+   *  targets are named, preprocessed and analyzed (see analyzeBlock())
+   *  before the first one is transformed, and the AST post-processing of
+   *  each modified file runs once after the last target instead of once
+   *  per target.
+   *
+   *  The statements must be outlineable, and no statement may contain
+   *  another one.
+   */
+  ROSE_DLL_API std::vector<Result> outline (const std::vector<SgStatement*>& stmts);
+
   //! If 's' is an outline pragma, this function "executes" it.
   /*!
    *  \post The outlined statement and the pragma are removed from the
@@ -181,6 +195,32 @@ namespace Outliner
      */
     Result outlineBlock (SgBasicBlock* b, const std::string& name);
 
+    //! The variables of an outlining target, as computed by analyzeBlock().
+    struct BlockAnalysis
+    {
+      ASTtools::VarSymSet_t syms; //!< Variables to be passed to the outlined function, see collectVars()
+      ASTtools::VarSymSet_t pdSyms; //!< Variables to be passed by their addresses (pointer dereferencing)
+      std::set<SgInitializedName*> readOnlyVars;
+      std::set<SgInitializedName*> liveIns, liveOuts;
+    };
+
+    /*!
+     *  \brief Runs the analyses of outlineBlock() on the basic block 'b'
+     *  without changing the AST.
+     *
+     *  Outlining a target does not change the variables of another target
+     *  which it does not contain, so the analyses of a batch of targets
+     *  can all be done before the first transformation.
+     */
+    void analyzeBlock (SgBasicBlock* b, BlockAnalysis& analysis);
+
+    /*!
+     *  \brief Outlines 'b' using the results of analyzeBlock(). Unless
+     *  'postProcess' is true, the caller is responsible for running
+     *  AstPostProcessing() on the files of the result afterwards.
+     */
+    Result outlineBlock (SgBasicBlock* b, const std::string& name, const BlockAnalysis& analysis, bool postProcess);
+
     /*!
      *  \brief Computes the set of variables in 's' that need to be
      *  passed to the outlined routine (semantically equivalent to shared variables in OpenMP) 
@@ -192,70 +192,92 @@ static void calculateVariableUsingAddressOf(const ASTtools::VarSymSet_t& syms, c
 }
 
 /**
- * Major work of outlining is done here
- *  Preparations: variable collection
- *  Generate outlined function
- *  Replace outlining target with a function call
- *  Append dependent declarations,headers to new file if needed
+ * Analysis of an outlining target, separated from the transformation so
+ * that the targets of a batch can all be analyzed before any of them is outlined
+ *  Variables to be passed to the outlined function
+ *  Read-only, pointer dereferencing, and live variables
  */
-Outliner::Result
-Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
+void
+Outliner::analyzeBlock (SgBasicBlock* s, BlockAnalysis& analysis)
 {
-  //---------step 1. Preparations-----------------------------------
-  //new file, cut preprocessing information, collect variables
-  // Generate a new source file for the outlined function, if requested
-  SgSourceFile* new_file = NULL;
-  if (Outliner::useNewFile)
-    new_file = generateNewSourceFile(s,func_name_str);
-
-  // Save some preprocessing information for later restoration. 
-  AttachedPreprocessingInfoType ppi_before, ppi_after;
-  ASTtools::cutPreprocInfo (s, PreprocessingInfo::before, ppi_before);
-  ASTtools::cutPreprocInfo (s, PreprocessingInfo::after, ppi_after);
-
   // Determine variables to be passed to outlined routine.
   // ----------------------------------------------------------
   // Also collect symbols which must use pointer dereferencing if replaced during outlining
-  ASTtools::VarSymSet_t syms, pdSyms;
-  collectVars (s, syms);
+  collectVars (s, analysis.syms);
 
   // prepare necessary analysis to optimize the outlining 
   //-----------------------------------------------------------------
-  std::set<SgInitializedName*> readOnlyVars;
-  std::set< SgInitializedName *> liveIns, liveOuts;
   // Collect read-only variables of the outlining target
 
   //Determine variables to be replaced by temp copy or pointer dereferencing.
   if (Outliner::temp_variable|| Outliner::enable_classic || Outliner::useStructureWrapper)
   {
-    SageInterface::collectReadOnlyVariables(s,readOnlyVars);
+    SageInterface::collectReadOnlyVariables(s,analysis.readOnlyVars);
     // Collect use by address plus non-assignable variables
     // They must be passed by reference if they need to be passed as parameters
     // TODO: this is not accurate: array variables are not assignable , but they should not using pointer dereferencing 
-    ASTtools::collectPointerDereferencingVarSyms(s,pdSyms);
+    ASTtools::collectPointerDereferencingVarSyms(s,analysis.pdSyms);
 
     // liveness analysis
+    // call_liveness_analysis() runs on the whole project once and returns the same result afterwards
     SgStatement* firstStmt = (s->get_statements())[0];
     if (isSgForStatement(firstStmt)&& enable_liveness)
     {
       LivenessAnalysis * liv = SageInterface::call_liveness_analysis (SageInterface::getProject());
-      SageInterface::getLiveVariables(liv, isSgForStatement(firstStmt), liveIns, liveOuts);
+      SageInterface::getLiveVariables(liv, isSgForStatement(firstStmt), analysis.liveIns, analysis.liveOuts);
     }
 
     if (Outliner::enable_debug)
     {
-      cout<<"Outliner::Transform::generateFunction() -----Found "<<readOnlyVars.size()<<" read only variables..:";
-      for (std::set<SgInitializedName*>::const_iterator iter = readOnlyVars.begin();
-          iter!=readOnlyVars.end(); iter++)
+      cout<<"Outliner::Transform::generateFunction() -----Found "<<analysis.readOnlyVars.size()<<" read only variables..:";
+      for (std::set<SgInitializedName*>::const_iterator iter = analysis.readOnlyVars.begin();
+          iter!=analysis.readOnlyVars.end(); iter++)
         cout<<" "<<(*iter)->get_name().getString()<<" ";
       cout<<endl;
-      cout<<"Outliner::Transform::generateFunction() -----Found "<<liveOuts.size()<<" live out variables..:";
-      for (std::set<SgInitializedName*>::const_iterator iter = liveOuts.begin();
-          iter!=liveOuts.end(); iter++)
+      cout<<"Outliner::Transform::generateFunction() -----Found "<<analysis.liveOuts.size()<<" live out variables..:";
+      for (std::set<SgInitializedName*>::const_iterator iter = analysis.liveOuts.begin();
+          iter!=analysis.liveOuts.end(); iter++)
         cout<<" "<<(*iter)->get_name().getString()<<" ";
       cout<<endl; 
     }
   }
+}
+
+Outliner::Result
+Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
+{
+  BlockAnalysis analysis;
+  analyzeBlock (s, analysis);
+  return outlineBlock (s, func_name_str, analysis, true);
+}
+
+/**
+ * Major work of outlining is done here
+ *  Preparations: variable collection (done by analyzeBlock())
+ *  Generate outlined function
+ *  Replace outlining target with a function call
+ *  Append dependent declarations,headers to new file if needed
+ */
+Outliner::Result
+Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str, const BlockAnalysis& analysis, bool postProcess)
+{
+  //---------step 1. Preparations-----------------------------------
+  //new file, cut preprocessing information
+  // Generate a new source file for the outlined function, if requested
+  SgSourceFile* new_file = NULL;
+  if (Outliner::useNewFile)
+    new_file = generateNewSourceFile(s,func_name_str);
+
+  // Save some preprocessing information for later restoration. 
+  AttachedPreprocessingInfoType ppi_before, ppi_after;
+  ASTtools::cutPreprocInfo (s, PreprocessingInfo::before, ppi_before);
+  ASTtools::cutPreprocInfo (s, PreprocessingInfo::after, ppi_after);
+
+  // The variable sets are updated below, so work on copies of the analysis results
+  ASTtools::VarSymSet_t syms = analysis.syms;
+  ASTtools::VarSymSet_t pdSyms = analysis.pdSyms;
+  const std::set<SgInitializedName*>& readOnlyVars = analysis.readOnlyVars;
+  const std::set<SgInitializedName*>& liveOuts = analysis.liveOuts;
 
   // Insert outlined function.
   // grab target scope first
@@ -457,20 +479,24 @@ Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
 
 #if 1
   // DQ (2/26/2009): Moved (here) to as late as possible so that all transformations are complete before running AstPostProcessing()
+  // A batch of targets (Outliner::outline(const std::vector<SgStatement*>&)) runs it once per file after its last target instead.
 
   // This fails for moreTest3.cpp
   // Run the AST fixup on the AST for the source file.
-  SgSourceFile* originalSourceFile = TransformationSupport::getSourceFile(src_scope);
-  //     printf ("##### Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
-  AstPostProcessing (originalSourceFile);
-  //     printf ("##### DONE: Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
+  if (postProcess)
+  {
+    SgSourceFile* originalSourceFile = TransformationSupport::getSourceFile(src_scope);
+    //     printf ("##### Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
+    AstPostProcessing (originalSourceFile);
+    //     printf ("##### DONE: Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
+  }
 #else
   printf ("Skipping call to AstPostProcessing (originalSourceFile); \n");
 #endif
 
   ROSE_ASSERT(func->get_definition()->get_body()->get_parent() == func->get_definition());
 
-  if (useNewFile == true)
+  if (useNewFile == true && postProcess)
   {
 #if 1
     // This fails for moreTest3.cpp
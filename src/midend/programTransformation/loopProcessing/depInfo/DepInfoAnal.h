@@ -72,10 +72,27 @@ class DepInfoAnal
 
   AstInterface& get_astInterface() { return varmodInfo.get_astInterface(); }
 
+  // forgets the loop information and the results of array dependence tests computed so far;
+  // must be called when the AST has been modified after the analysis was created
+  void ClearCache();
+
  private:
+        // identifies a dependence test between two array references (see ComputeArrayDepCached);
+        // ref1 and ref2 are only set if the subscripts use a variable modified in the common loop
+        struct ArrayDepKey {
+          AstNodePtr loop1, loop2, commLoop, ref1, ref2;
+          int commLevel;
+          DepType deptype;
+          std::string subscripts1, subscripts2;
+          bool operator < (const ArrayDepKey& that) const;
+        };
+
         DependenceTesting& handle;
         std::map <AstNodePtr, LoopDepInfo, std::less <AstNodePtr> > stmtInfo;
         ModifyVariableInfo varmodInfo;
+        std::map <ArrayDepKey, DepInfo> arrayDepCache;
+
+        DepInfo ComputeArrayDepCached( const StmtRefDep& ref, DepType deptype);
 };
 
 class DependenceTesting{
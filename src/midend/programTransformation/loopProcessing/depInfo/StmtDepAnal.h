@@ -26,6 +26,9 @@ bool SplitEquation( CoeffVec& cur,
 template <class Mat>
 bool NormalizeMatrix( Mat& analMatrix, int rows, int cols);
 
+template <class CoeffVec, class BoundVec>
+bool HasNoIntegerSolution(const CoeffVec& vec, const BoundVec& bounds);
+
 template <class CoeffVec, class BoundVec, class BoundOp, class Dep>
 bool AnalyzeEquation(const CoeffVec& vec, const BoundVec& bounds,
                         BoundOp& boundop, Dep& result, const DepRel& rel) ;
@@ -1,7 +1,15 @@
 #include "rose_config.h"
 #include "libxomp.h"
 
-#ifdef USE_ROSE_GOMP_OPENMP_LIBRARY 
+#ifdef USE_ROSE_NATIVE_OPENMP_LIBRARY
+// The native runtime implements the GOMP entry points used below
+#include "xomp_native.h"
+#undef USE_ROSE_OMNI_OPENMP_SUPPORT
+#ifndef USE_ROSE_GOMP_OPENMP_LIBRARY
+#define USE_ROSE_GOMP_OPENMP_LIBRARY
+#endif
+
+#elif defined(USE_ROSE_GOMP_OPENMP_LIBRARY)
 
 // GOMP header
 #include "libgomp_g.h"
@@ -0,0 +1,910 @@
+/*  A native runtime for XOMP, used instead of GOMP or Omni when ROSE is
+ *  configured with --enable-native-xomp. See xomp_native.h for an overview.
+ *
+ *  One team runs at a time: the threads of a parallel region started while
+ *  another one is running (nested or from another system thread) form a team
+ *  of one thread.
+ *  */
+#include "rose_config.h"
+
+#ifdef USE_ROSE_NATIVE_OPENMP_LIBRARY
+
+#include "xomp_native.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h> // for getenv(), malloc()
+#include <stdio.h>
+#include <string.h> // for memcpy(), strncasecmp()
+#include <strings.h>
+#include <unistd.h> // for sysconf()
+#include <assert.h>
+#include <sys/time.h>
+
+#define XOMP_NATIVE_MAX_THREADS 256
+#define XOMP_NATIVE_BARRIER_ROUNDS 8    // log2(XOMP_NATIVE_MAX_THREADS)
+#define XOMP_NATIVE_WORK_SHARES 8       // work-sharing constructs a thread may run ahead by (nowait)
+#define XOMP_NATIVE_DEQUE_SIZE 1024     // tasks per thread's deque, a power of 2
+#define XOMP_NATIVE_SPIN_COUNT 20000    // busy-wait iterations before yielding or sleeping
+#define XOMP_NATIVE_CACHE_LINE 64
+
+#if defined(__i386__) || defined(__x86_64__)
+#define XOMP_NATIVE_PAUSE() __builtin_ia32_pause ()
+#else
+#define XOMP_NATIVE_PAUSE() __sync_synchronize ()
+#endif
+
+#define XOMP_NATIVE_LOAD(p) __atomic_load_n ((p), __ATOMIC_ACQUIRE)
+#define XOMP_NATIVE_STORE(p, v) __atomic_store_n ((p), (v), __ATOMIC_RELEASE)
+
+enum xomp_native_schedule
+{
+  e_native_static,
+  e_native_dynamic,
+  e_native_guided
+};
+
+struct xomp_native_task
+{
+  void (*fn) (void *);
+  void *data;                           // points into the memory after this struct
+  struct xomp_native_task *parent;
+  long children;                        // children not yet completed, for taskwait
+  long refs;                            // 1 until the task completes, plus 1 per child not yet completed
+};
+
+// Chase-Lev work-stealing deque: the owner pushes and pops at the bottom, other threads steal from the top
+struct xomp_native_deque
+{
+  long top __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+  long bottom __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+  struct xomp_native_task *slots[XOMP_NATIVE_DEQUE_SIZE];
+};
+
+// State of one work-sharing construct (loop or sections), shared by the team
+struct xomp_native_work_share
+{
+  long claimed;                         // sequence number of the construct whose first thread initializes this slot
+  long ready;                           // sequence number of the construct this slot is initialized for
+  long left;                            // threads that have not finished the construct
+  enum xomp_native_schedule schedule;
+  bool ordered;
+  long start, incr, count, chunk;       // iteration i is start + i*incr, 0 <= i < count
+  long next __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));  // first iteration not yet handed out (dynamic, guided)
+  long ordered_next __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE))); // first iteration of the chunk allowed into ordered regions
+} __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+
+struct xomp_native_team;
+
+struct xomp_native_thread
+{
+  int id;
+  struct xomp_native_team *team;
+  struct xomp_native_thread *saved;     // the thread's context outside the region it is master of
+  struct xomp_native_task implicit_task;
+  struct xomp_native_task *current_task;
+  long work_share_seq;                  // work-sharing constructs started in this region
+  struct xomp_native_work_share *work_share;
+  long static_trip;                     // chunks taken from the current static loop
+  long chunk_start, chunk_end;          // iterations of the current chunk
+  long single_seq;
+  long barrier_episode;
+  long generation;                      // last team start seen by a worker
+  unsigned int steal_seed;
+  long barrier_flags[XOMP_NATIVE_BARRIER_ROUNDS] __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+  struct xomp_native_deque deque;
+};
+
+struct xomp_native_team
+{
+  void (*fn) (void *);
+  void *data;
+  int nthreads;
+  struct xomp_native_thread **threads;
+  bool is_pool_team;                    // run by the thread pool, else a team of one thread allocated for the region
+  long pending_tasks __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+  long single_claimed __attribute__ ((aligned (XOMP_NATIVE_CACHE_LINE)));
+  struct xomp_native_work_share work_shares[XOMP_NATIVE_WORK_SHARES];
+};
+
+//---------------------------------------------
+// Global state
+static pthread_once_t xomp_native_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t xomp_native_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xomp_native_pool_cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t xomp_native_critical_lock = PTHREAD_MUTEX_INITIALIZER; // for named critical creation
+static pthread_mutex_t xomp_native_atomic_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct xomp_native_thread *xomp_native_pool[XOMP_NATIVE_MAX_THREADS]; // [0] is the master's context
+static int xomp_native_pool_size = 1;
+static long xomp_native_generation = 0;     // incremented to start the pool team
+static long xomp_native_active_workers = 0; // workers that have not yet finished with the last team
+static int xomp_native_sleeping = 0;        // workers blocked on xomp_native_pool_cond
+static int xomp_native_pool_busy = 0;       // the pool team is running
+static struct xomp_native_team xomp_native_pool_team;
+
+static int xomp_native_spin_count = XOMP_NATIVE_SPIN_COUNT; // 1 while there are more threads than processors
+static int xomp_native_nthreads_var = 1;    // OMP_NUM_THREADS or omp_set_num_threads()
+static enum xomp_native_schedule xomp_native_run_sched = e_native_static; // OMP_SCHEDULE
+static long xomp_native_run_chunk = 0;
+
+static __thread struct xomp_native_thread *xomp_native_self = NULL;
+
+//---------------------------------------------
+// Helpers
+static void xomp_native_backoff (int *spins)
+{
+  if (++(*spins) < xomp_native_spin_count)
+    XOMP_NATIVE_PAUSE ();
+  else
+    sched_yield ();
+}
+
+static int xomp_native_num_procs (void)
+{
+  long n = sysconf (_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (int) n : 1;
+}
+
+static void xomp_native_initialize (void)
+{
+  char *env = getenv ("OMP_NUM_THREADS");
+  int n = env != NULL ? atoi (env) : 0;
+  if (n <= 0)
+    n = xomp_native_num_procs ();
+  xomp_native_nthreads_var = n < XOMP_NATIVE_MAX_THREADS ? n : XOMP_NATIVE_MAX_THREADS;
+
+  // OMP_SCHEDULE=kind[,chunk]
+  env = getenv ("OMP_SCHEDULE");
+  if (env != NULL)
+  {
+    char *comma = strchr (env, ',');
+    if (strncasecmp (env, "dynamic", 7) == 0)
+      xomp_native_run_sched = e_native_dynamic;
+    else if (strncasecmp (env, "guided", 6) == 0)
+      xomp_native_run_sched = e_native_guided;
+    else
+      xomp_native_run_sched = e_native_static;
+    if (comma != NULL)
+      xomp_native_run_chunk = atol (comma + 1);
+  }
+}
+
+static struct xomp_native_thread *xomp_native_new_thread (int id)
+{
+  void *memory = NULL;
+  if (posix_memalign (&memory, XOMP_NATIVE_CACHE_LINE, sizeof (struct xomp_native_thread)) != 0)
+  {
+    printf ("Error: xomp_native_new_thread(): out of memory\n");
+    abort ();
+  }
+  struct xomp_native_thread *thread = (struct xomp_native_thread *) memory;
+  memset (thread, 0, sizeof (*thread));
+  thread->id = id;
+  thread->steal_seed = 2654435761u * (unsigned int) (id + 1);
+  return thread;
+}
+
+static void xomp_native_reset_thread (struct xomp_native_thread *thread, struct xomp_native_team *team, int id)
+{
+  int i;
+  thread->id = id;
+  thread->team = team;
+  thread->implicit_task.parent = NULL;
+  thread->implicit_task.children = 0;
+  thread->implicit_task.refs = 1;       // never released: implicit tasks are not freed
+  thread->current_task = &thread->implicit_task;
+  thread->work_share_seq = 0;
+  thread->work_share = NULL;
+  thread->single_seq = 0;
+  thread->barrier_episode = 0;
+  for (i = 0; i < XOMP_NATIVE_BARRIER_ROUNDS; ++i)
+    thread->barrier_flags[i] = 0;
+}
+
+static void xomp_native_reset_team (struct xomp_native_team *team, void (*fn) (void *), void *data, int nthreads)
+{
+  int i;
+  team->fn = fn;
+  team->data = data;
+  team->nthreads = nthreads;
+  team->pending_tasks = 0;
+  team->single_claimed = 0;
+  for (i = 0; i < XOMP_NATIVE_WORK_SHARES; ++i)
+  {
+    // Construct number seq (counting from 1) uses slot seq % XOMP_NATIVE_WORK_SHARES, after construct seq - XOMP_NATIVE_WORK_SHARES
+    long first = i > 0 ? i : XOMP_NATIVE_WORK_SHARES;
+    team->work_shares[i].claimed = first - XOMP_NATIVE_WORK_SHARES;
+    team->work_shares[i].ready = first - XOMP_NATIVE_WORK_SHARES;
+    team->work_shares[i].left = 0;
+  }
+}
+
+// The calling thread's context; outside parallel regions it is the only thread of its own team
+static struct xomp_native_thread *xomp_native_current (void)
+{
+  struct xomp_native_thread *self = xomp_native_self;
+  if (self == NULL)
+  {
+    pthread_once (&xomp_native_once, xomp_native_initialize);
+    struct xomp_native_team *team = (struct xomp_native_team *) calloc (1, sizeof (struct xomp_native_team) + sizeof (self));
+    assert (team != NULL);
+    team->threads = (struct xomp_native_thread **) (team + 1);
+    self = xomp_native_new_thread (0);
+    team->threads[0] = self;
+    xomp_native_reset_team (team, NULL, NULL, 1);
+    xomp_native_reset_thread (self, team, 0);
+    xomp_native_self = self;
+  }
+  return self;
+}
+
+//---------------------------------------------
+// Task deques
+static bool xomp_native_deque_push (struct xomp_native_deque *d, struct xomp_native_task *task)
+{
+  long b = __atomic_load_n (&d->bottom, __ATOMIC_RELAXED);
+  long t = __atomic_load_n (&d->top, __ATOMIC_ACQUIRE);
+  if (b - t >= XOMP_NATIVE_DEQUE_SIZE)
+    return false;
+  __atomic_store_n (&d->slots[b & (XOMP_NATIVE_DEQUE_SIZE - 1)], task, __ATOMIC_RELAXED);
+  __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+static struct xomp_native_task *xomp_native_deque_pop (struct xomp_native_deque *d)
+{
+  long b = __atomic_load_n (&d->bottom, __ATOMIC_RELAXED) - 1;
+  __atomic_store_n (&d->bottom, b, __ATOMIC_RELAXED);
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  long t = __atomic_load_n (&d->top, __ATOMIC_RELAXED);
+  struct xomp_native_task *task = NULL;
+  if (t <= b)
+  {
+    task = __atomic_load_n (&d->slots[b & (XOMP_NATIVE_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+    if (t == b)
+    {
+      // The last task: race against thieves for it
+      if (!__atomic_compare_exchange_n (&d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        task = NULL;
+      __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+  }
+  else
+    __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELAXED);
+  return task;
+}
+
+static struct xomp_native_task *xomp_native_deque_steal (struct xomp_native_deque *d)
+{
+  long t = __atomic_load_n (&d->top, __ATOMIC_ACQUIRE);
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  long b = __atomic_load_n (&d->bottom, __ATOMIC_ACQUIRE);
+  if (t < b)
+  {
+    struct xomp_native_task *task = __atomic_load_n (&d->slots[t & (XOMP_NATIVE_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+    if (__atomic_compare_exchange_n (&d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+      return task;
+  }
+  return NULL;
+}
+
+//---------------------------------------------
+// Tasks
+static void xomp_native_task_release (struct xomp_native_task *task)
+{
+  if (__atomic_sub_fetch (&task->refs, 1, __ATOMIC_ACQ_REL) == 0)
+    free (task);
+}
+
+static void xomp_native_task_execute (struct xomp_native_thread *self, struct xomp_native_task *task)
+{
+  struct xomp_native_task *previous = self->current_task;
+  struct xomp_native_task *parent = task->parent;
+  self->current_task = task;
+  task->fn (task->data);
+  self->current_task = previous;
+
+  xomp_native_task_release (task);
+  __atomic_sub_fetch (&parent->children, 1, __ATOMIC_RELEASE);
+  xomp_native_task_release (parent);
+  __atomic_sub_fetch (&self->team->pending_tasks, 1, __ATOMIC_RELEASE);
+}
+
+// Run a task from the own deque, or else one stolen from another thread. Returns false if none was found.
+static bool xomp_native_run_one_task (struct xomp_native_thread *self)
+{
+  struct xomp_native_team *team = self->team;
+  struct xomp_native_task *task;
+  int i;
+
+  if (XOMP_NATIVE_LOAD (&team->pending_tasks) == 0)
+    return false;
+  task = xomp_native_deque_pop (&self->deque);
+  if (task == NULL && team->nthreads > 1)
+  {
+    // Random victim first, then the others in order
+    self->steal_seed = self->steal_seed * 1103515245u + 12345u;
+    int victim = (int) ((self->steal_seed >> 16) % (unsigned int) team->nthreads);
+    for (i = 0; i < team->nthreads && task == NULL; ++i)
+    {
+      struct xomp_native_thread *other = team->threads[(victim + i) % team->nthreads];
+      if (other != self)
+        task = xomp_native_deque_steal (&other->deque);
+    }
+  }
+  if (task == NULL)
+    return false;
+  xomp_native_task_execute (self, task);
+  return true;
+}
+
+void xomp_native_task (void (*fn) (void *), void *data, void (*cpyfn) (void *, void *),
+                       long arg_size, long arg_align, bool if_clause, unsigned flags)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  struct xomp_native_team *team = self->team;
+  struct xomp_native_task *parent = self->current_task;
+  (void) flags; // untied tasks are scheduled like tied ones
+
+  if (arg_align < 1)
+    arg_align = 1;
+  struct xomp_native_task *task = (struct xomp_native_task *) malloc (sizeof (struct xomp_native_task) + arg_size + arg_align - 1);
+  assert (task != NULL);
+  char *arg = (char *) (task + 1);
+  arg += (arg_align - (long) ((size_t) arg % (size_t) arg_align)) % arg_align;
+  // The data of a task is copied when it is created, since the creator's stack frame may be gone when it runs
+  if (cpyfn != NULL)
+    cpyfn (arg, data);
+  else if (arg_size > 0)
+    memcpy (arg, data, arg_size);
+  task->fn = fn;
+  task->data = arg;
+  task->parent = parent;
+  task->children = 0;
+  task->refs = 1;
+
+  __atomic_add_fetch (&parent->children, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&parent->refs, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&team->pending_tasks, 1, __ATOMIC_RELEASE);
+
+  // Undeferred if the if clause is false, there is no other thread to run it, or the deque is full
+  if (!if_clause || team->nthreads == 1 || !xomp_native_deque_push (&self->deque, task))
+    xomp_native_task_execute (self, task);
+}
+
+void xomp_native_taskwait (void)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  struct xomp_native_task *current = self->current_task;
+  int spins = 0;
+  while (XOMP_NATIVE_LOAD (&current->children) > 0)
+  {
+    if (xomp_native_run_one_task (self))
+      spins = 0;
+    else
+      xomp_native_backoff (&spins);
+  }
+}
+
+//---------------------------------------------
+// Barrier
+// The team's tasks are completed first. Then a dissemination barrier: in round r, thread i signals
+// thread (i + 2^r) % n and waits for thread (i - 2^r) % n. Flags hold barrier episode numbers, so they
+// never need to be reset within a region. Threads run tasks while they wait.
+static void xomp_native_barrier_wait (struct xomp_native_thread *self)
+{
+  struct xomp_native_team *team = self->team;
+  int n = team->nthreads;
+  int spins = 0;
+  int round, distance;
+
+  while (XOMP_NATIVE_LOAD (&team->pending_tasks) > 0)
+  {
+    if (xomp_native_run_one_task (self))
+      spins = 0;
+    else
+      xomp_native_backoff (&spins);
+  }
+  if (n == 1)
+    return;
+
+  long episode = ++self->barrier_episode;
+  for (round = 0, distance = 1; distance < n; ++round, distance <<= 1)
+  {
+    struct xomp_native_thread *partner = team->threads[(self->id + distance) % n];
+    XOMP_NATIVE_STORE (&partner->barrier_flags[round], episode);
+    spins = 0;
+    while (XOMP_NATIVE_LOAD (&self->barrier_flags[round]) < episode)
+    {
+      if (!xomp_native_run_one_task (self))
+        xomp_native_backoff (&spins);
+    }
+  }
+}
+
+void xomp_native_barrier (void)
+{
+  xomp_native_barrier_wait (xomp_native_current ());
+}
+
+//---------------------------------------------
+// Parallel regions
+static long xomp_native_wait_for_team (long seen)
+{
+  long generation;
+  int spins;
+  for (spins = 0; spins < xomp_native_spin_count; ++spins)
+  {
+    generation = XOMP_NATIVE_LOAD (&xomp_native_generation);
+    if (generation != seen)
+      return generation;
+    XOMP_NATIVE_PAUSE ();
+  }
+
+  pthread_mutex_lock (&xomp_native_pool_lock);
+  ++xomp_native_sleeping;
+  while ((generation = XOMP_NATIVE_LOAD (&xomp_native_generation)) == seen)
+    pthread_cond_wait (&xomp_native_pool_cond, &xomp_native_pool_lock);
+  --xomp_native_sleeping;
+  pthread_mutex_unlock (&xomp_native_pool_lock);
+  return generation;
+}
+
+static void *xomp_native_worker (void *arg)
+{
+  struct xomp_native_thread *self = (struct xomp_native_thread *) arg;
+  xomp_native_self = self;
+  for (;;)
+  {
+    self->generation = xomp_native_wait_for_team (self->generation);
+    struct xomp_native_team *team = &xomp_native_pool_team;
+    if (self->id < team->nthreads)
+    {
+      team->fn (team->data);
+      xomp_native_barrier_wait (self); // implicit barrier at the end of the region
+    }
+    __atomic_sub_fetch (&xomp_native_active_workers, 1, __ATOMIC_RELEASE);
+  }
+  return NULL;
+}
+
+// Add workers to the pool until it has n threads, counting the master
+static void xomp_native_grow_pool (int n)
+{
+  pthread_attr_t attr;
+  pthread_attr_init (&attr);
+  pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+  while (xomp_native_pool_size < n)
+  {
+    pthread_t pthread;
+    struct xomp_native_thread *thread = xomp_native_new_thread (xomp_native_pool_size);
+    thread->generation = xomp_native_generation;
+    if (pthread_create (&pthread, &attr, xomp_native_worker, thread) != 0)
+    {
+      free (thread);
+      break;
+    }
+    xomp_native_pool[xomp_native_pool_size++] = thread;
+  }
+  pthread_attr_destroy (&attr);
+}
+
+void xomp_native_parallel_start (void (*fn) (void *), void *data, unsigned num_threads)
+{
+  struct xomp_native_thread *outer = xomp_native_current ();
+  int n = num_threads > 0 ? (int) num_threads : xomp_native_nthreads_var;
+  int i, spins = 0;
+  int expected = 0;
+  if (n > XOMP_NATIVE_MAX_THREADS)
+    n = XOMP_NATIVE_MAX_THREADS;
+
+  if (n == 1 || !__atomic_compare_exchange_n (&xomp_native_pool_busy, &expected, 1, false,
+                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+  {
+    // A team of one thread, for a nested region or one that asked for a single thread
+    struct xomp_native_team *team = (struct xomp_native_team *) calloc (1, sizeof (struct xomp_native_team) + sizeof (outer));
+    assert (team != NULL);
+    team->threads = (struct xomp_native_thread **) (team + 1);
+    struct xomp_native_thread *self = xomp_native_new_thread (0);
+    team->threads[0] = self;
+    team->is_pool_team = false;
+    xomp_native_reset_team (team, fn, data, 1);
+    xomp_native_reset_thread (self, team, 0);
+    self->saved = outer;
+    xomp_native_self = self;
+    return;
+  }
+
+  // Wait until the workers are done with the last team, then set up the new one
+  while (XOMP_NATIVE_LOAD (&xomp_native_active_workers) > 0)
+    xomp_native_backoff (&spins);
+  if (xomp_native_pool[0] == NULL)
+    xomp_native_pool[0] = xomp_native_new_thread (0);
+  xomp_native_grow_pool (n);
+  if (n > xomp_native_pool_size)
+    n = xomp_native_pool_size;
+  // Spinning only delays the threads being waited for if they have to share processors
+  xomp_native_spin_count = n > xomp_native_num_procs () ? 1 : XOMP_NATIVE_SPIN_COUNT;
+
+  struct xomp_native_team *team = &xomp_native_pool_team;
+  team->threads = xomp_native_pool;
+  team->is_pool_team = true;
+  xomp_native_reset_team (team, fn, data, n);
+  for (i = 0; i < n; ++i)
+    xomp_native_reset_thread (xomp_native_pool[i], team, i);
+  xomp_native_pool[0]->saved = outer;
+  xomp_native_self = xomp_native_pool[0];
+
+  // Start the workers
+  xomp_native_active_workers = xomp_native_pool_size - 1;
+  XOMP_NATIVE_STORE (&xomp_native_generation, xomp_native_generation + 1);
+  pthread_mutex_lock (&xomp_native_pool_lock);
+  if (xomp_native_sleeping > 0)
+    pthread_cond_broadcast (&xomp_native_pool_cond);
+  pthread_mutex_unlock (&xomp_native_pool_lock);
+}
+
+void xomp_native_parallel_end (void)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  struct xomp_native_team *team = self->team;
+  assert (self->id == 0);
+
+  xomp_native_barrier_wait (self);
+  xomp_native_self = self->saved;
+  if (team->is_pool_team)
+    XOMP_NATIVE_STORE (&xomp_native_pool_busy, 0);
+  else
+  {
+    free (self);
+    free (team);
+  }
+}
+
+//---------------------------------------------
+// Work sharing
+static void xomp_native_work_share_begin (struct xomp_native_thread *self, enum xomp_native_schedule schedule, bool ordered,
+                                          long start, long end, long incr, long chunk)
+{
+  struct xomp_native_team *team = self->team;
+  long seq = ++self->work_share_seq;
+  struct xomp_native_work_share *ws = &team->work_shares[seq % XOMP_NATIVE_WORK_SHARES];
+  long expected = seq - XOMP_NATIVE_WORK_SHARES;
+  int spins = 0;
+
+  if (__atomic_compare_exchange_n (&ws->claimed, &expected, seq, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+  {
+    // First thread to arrive: wait until the slot's last construct is finished by all threads, then initialize
+    while (XOMP_NATIVE_LOAD (&ws->left) > 0)
+      xomp_native_backoff (&spins);
+    ws->schedule = schedule;
+    ws->ordered = ordered;
+    ws->start = start;
+    ws->incr = incr;
+    if (incr > 0)
+      ws->count = end > start ? (end - start + incr - 1) / incr : 0;
+    else
+      ws->count = start > end ? (start - end - incr - 1) / (-incr) : 0;
+    ws->chunk = chunk;
+    ws->next = 0;
+    ws->ordered_next = 0;
+    ws->left = team->nthreads;
+    XOMP_NATIVE_STORE (&ws->ready, seq);
+  }
+  else
+  {
+    while (XOMP_NATIVE_LOAD (&ws->ready) < seq)
+      xomp_native_backoff (&spins);
+  }
+
+  self->work_share = ws;
+  self->static_trip = 0;
+  self->chunk_start = self->chunk_end = 0;
+}
+
+// Let the next chunk into ordered regions once the current chunk's turn has come
+static void xomp_native_ordered_pass (struct xomp_native_thread *self)
+{
+  struct xomp_native_work_share *ws = self->work_share;
+  int spins = 0;
+  if (!ws->ordered || self->chunk_start == self->chunk_end)
+    return;
+  while (XOMP_NATIVE_LOAD (&ws->ordered_next) != self->chunk_start)
+    xomp_native_backoff (&spins);
+  XOMP_NATIVE_STORE (&ws->ordered_next, self->chunk_end);
+  self->chunk_start = self->chunk_end;
+}
+
+static void xomp_native_work_share_end (struct xomp_native_thread *self)
+{
+  xomp_native_ordered_pass (self);
+  __atomic_sub_fetch (&self->work_share->left, 1, __ATOMIC_RELEASE);
+  self->work_share = NULL;
+}
+
+// Hand out the next chunk of the current loop; false if there are no iterations left
+static bool xomp_native_loop_next (struct xomp_native_thread *self, long *istart, long *iend)
+{
+  struct xomp_native_work_share *ws = self->work_share;
+  int nthreads = self->team->nthreads;
+  long first, size;
+
+  xomp_native_ordered_pass (self);
+  switch (ws->schedule)
+  {
+    case e_native_static:
+      if (ws->chunk <= 0)
+      {
+        // One block per thread, sizes differing by at most one
+        long quotient = ws->count / nthreads, remainder = ws->count % nthreads;
+        if (self->static_trip++ > 0)
+          return false;
+        first = self->id * quotient + (self->id < remainder ? self->id : remainder);
+        size = quotient + (self->id < remainder ? 1 : 0);
+      }
+      else
+      {
+        // Chunks round robin
+        first = (self->static_trip * nthreads + self->id) * ws->chunk;
+        if (first >= ws->count)
+          return false;
+        ++self->static_trip;
+        size = ws->chunk;
+      }
+      break;
+    case e_native_dynamic:
+      first = __atomic_fetch_add (&ws->next, ws->chunk, __ATOMIC_RELAXED);
+      size = ws->chunk;
+      break;
+    case e_native_guided:
+      first = __atomic_load_n (&ws->next, __ATOMIC_RELAXED);
+      do
+      {
+        long remaining = ws->count - first;
+        if (remaining <= 0)
+          return false;
+        size = (remaining + nthreads - 1) / nthreads;
+        if (size < ws->chunk)
+          size = ws->chunk;
+      } while (!__atomic_compare_exchange_n (&ws->next, &first, first + size, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+      break;
+    default:
+      assert (0);
+      return false;
+  }
+
+  if (first >= ws->count || size <= 0)
+    return false;
+  if (size > ws->count - first)
+    size = ws->count - first;
+  self->chunk_start = first;
+  self->chunk_end = first + size;
+  *istart = ws->start + first * ws->incr;
+  *iend = ws->start + (first + size) * ws->incr;
+  return true;
+}
+
+static bool xomp_native_loop_start (enum xomp_native_schedule schedule, bool ordered, long start, long end, long incr,
+                                    long chunk, long *istart, long *iend)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  if (schedule != e_native_static && chunk < 1)
+    chunk = 1;
+  xomp_native_work_share_begin (self, schedule, ordered, start, end, incr, chunk);
+  return xomp_native_loop_next (self, istart, iend);
+}
+
+bool xomp_native_loop_static_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_static, false, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_dynamic_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_dynamic, false, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_guided_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_guided, false, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_runtime_start (long start, long end, long incr, long *istart, long *iend)
+{
+  pthread_once (&xomp_native_once, xomp_native_initialize);
+  return xomp_native_loop_start (xomp_native_run_sched, false, start, end, incr, xomp_native_run_chunk, istart, iend);
+}
+
+bool xomp_native_loop_ordered_static_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_static, true, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_ordered_dynamic_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_dynamic, true, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_ordered_guided_start (long start, long end, long incr, long chunk, long *istart, long *iend)
+{
+  return xomp_native_loop_start (e_native_guided, true, start, end, incr, chunk, istart, iend);
+}
+bool xomp_native_loop_ordered_runtime_start (long start, long end, long incr, long *istart, long *iend)
+{
+  pthread_once (&xomp_native_once, xomp_native_initialize);
+  return xomp_native_loop_start (xomp_native_run_sched, true, start, end, incr, xomp_native_run_chunk, istart, iend);
+}
+
+// The schedule is recorded in the work share, so all kinds of next share one implementation
+bool xomp_native_loop_static_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_dynamic_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_guided_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_runtime_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_ordered_static_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_ordered_dynamic_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_ordered_guided_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+bool xomp_native_loop_ordered_runtime_next (long *istart, long *iend)
+{
+  return xomp_native_loop_next (xomp_native_current (), istart, iend);
+}
+
+void xomp_native_loop_end (void)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  xomp_native_work_share_end (self);
+  xomp_native_barrier_wait (self);
+}
+
+void xomp_native_loop_end_nowait (void)
+{
+  xomp_native_work_share_end (xomp_native_current ());
+}
+
+// Ordering is by chunk: a chunk may enter ordered regions once all earlier chunks are finished
+void xomp_native_ordered_start (void)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  int spins = 0;
+  assert (self->work_share != NULL);
+  while (XOMP_NATIVE_LOAD (&self->work_share->ordered_next) != self->chunk_start)
+    xomp_native_backoff (&spins);
+}
+
+void xomp_native_ordered_end (void)
+{
+}
+
+// Sections are a dynamic loop over section numbers 1..count with chunks of one
+unsigned xomp_native_sections_start (unsigned count)
+{
+  long istart, iend;
+  if (xomp_native_loop_start (e_native_dynamic, false, 1, (long) count + 1, 1, 1, &istart, &iend))
+    return (unsigned) istart;
+  return 0;
+}
+
+unsigned xomp_native_sections_next (void)
+{
+  long istart, iend;
+  if (xomp_native_loop_next (xomp_native_current (), &istart, &iend))
+    return (unsigned) istart;
+  return 0;
+}
+
+void xomp_native_sections_end (void)
+{
+  xomp_native_loop_end ();
+}
+
+void xomp_native_sections_end_nowait (void)
+{
+  xomp_native_loop_end_nowait ();
+}
+
+// The first thread to reach the n-th single construct of the region executes it
+bool xomp_native_single_start (void)
+{
+  struct xomp_native_thread *self = xomp_native_current ();
+  long seq = ++self->single_seq;
+  long claimed = XOMP_NATIVE_LOAD (&self->team->single_claimed);
+  return claimed < seq && __atomic_compare_exchange_n (&self->team->single_claimed, &claimed, seq, false,
+                                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+//---------------------------------------------
+// Mutual exclusion
+void xomp_native_critical_name_start (void **name)
+{
+  pthread_mutex_t *lock = (pthread_mutex_t *) XOMP_NATIVE_LOAD (name);
+  if (lock == NULL)
+  {
+    pthread_mutex_lock (&xomp_native_critical_lock);
+    lock = (pthread_mutex_t *) *name;
+    if (lock == NULL)
+    {
+      lock = (pthread_mutex_t *) malloc (sizeof (pthread_mutex_t));
+      assert (lock != NULL);
+      pthread_mutex_init (lock, NULL);
+      XOMP_NATIVE_STORE (name, (void *) lock);
+    }
+    pthread_mutex_unlock (&xomp_native_critical_lock);
+  }
+  pthread_mutex_lock (lock);
+}
+
+void xomp_native_critical_name_end (void **name)
+{
+  pthread_mutex_unlock ((pthread_mutex_t *) *name);
+}
+
+void xomp_native_atomic_start (void)
+{
+  pthread_mutex_lock (&xomp_native_atomic_lock);
+}
+
+void xomp_native_atomic_end (void)
+{
+  pthread_mutex_unlock (&xomp_native_atomic_lock);
+}
+
+//---------------------------------------------
+// The OpenMP query functions that lowered code and xomp.c use. Other omp.h functions (locks, etc.)
+// can still come from an OpenMP runtime library linked after libxomp.
+int omp_get_thread_num (void)
+{
+  return xomp_native_self != NULL ? xomp_native_self->id : 0;
+}
+
+int omp_get_num_threads (void)
+{
+  return xomp_native_self != NULL ? xomp_native_self->team->nthreads : 1;
+}
+
+int omp_get_max_threads (void)
+{
+  pthread_once (&xomp_native_once, xomp_native_initialize);
+  return xomp_native_nthreads_var;
+}
+
+void omp_set_num_threads (int n)
+{
+  pthread_once (&xomp_native_once, xomp_native_initialize);
+  if (n > 0)
+    xomp_native_nthreads_var = n < XOMP_NATIVE_MAX_THREADS ? n : XOMP_NATIVE_MAX_THREADS;
+}
+
+int omp_in_parallel (void)
+{
+  return omp_get_num_threads () > 1;
+}
+
+int omp_get_num_procs (void)
+{
+  return xomp_native_num_procs ();
+}
+
+double omp_get_wtime (void)
+{
+  struct timeval t;
+  gettimeofday (&t, NULL);
+  return t.tv_sec + 1.0e-6 * t.tv_usec;
+}
+
+#endif /* USE_ROSE_NATIVE_OPENMP_LIBRARY */
@@ -0,0 +1,114 @@
+/*  The native XOMP runtime's interface to xomp.c
+ *
+ *  The native runtime (xomp_native.c) is a self-contained implementation of the
+ *  part of the GOMP interface (see libgomp_g.h) that xomp.c uses, plus the
+ *  omp_*() query functions. It is used instead of GOMP or Omni when ROSE is
+ *  configured with --enable-native-xomp. It has
+ *    a persistent pool of worker threads, which spin for a while and then sleep between parallel regions,
+ *    a per-thread work-stealing deque of tasks,
+ *    lock-free chunk dispatch (one atomic add per chunk) for dynamic and guided loops, and
+ *    a dissemination barrier, during which waiting threads execute pending tasks.
+ *
+ *  Nested parallel regions are run by a team of one thread, as with the other XOMP backends.
+ *
+ *  The GOMP code paths in xomp.c are reused with the GOMP_* names mapped to
+ *  the xomp_native_* functions below, so the two backends share the bounds
+ *  conversions of the XOMP layer.
+ *  */
+#ifndef XOMP_NATIVE_H
+#define XOMP_NATIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+extern void xomp_native_parallel_start (void (*) (void *), void *, unsigned);
+extern void xomp_native_parallel_end (void);
+
+extern void xomp_native_barrier (void);
+extern void xomp_native_critical_name_start (void **);
+extern void xomp_native_critical_name_end (void **);
+extern void xomp_native_atomic_start (void);
+extern void xomp_native_atomic_end (void);
+
+extern void xomp_native_task (void (*) (void *), void *, void (*) (void *, void *),
+                              long, long, bool, unsigned);
+extern void xomp_native_taskwait (void);
+
+extern unsigned xomp_native_sections_start (unsigned);
+extern unsigned xomp_native_sections_next (void);
+extern void xomp_native_sections_end (void);
+extern void xomp_native_sections_end_nowait (void);
+
+extern bool xomp_native_single_start (void);
+
+// Loop bounds follow GOMP: the upper bound is non-inclusive
+extern bool xomp_native_loop_static_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_dynamic_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_guided_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_runtime_start (long, long, long, long *, long *);
+
+extern bool xomp_native_loop_ordered_static_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_ordered_dynamic_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_ordered_guided_start (long, long, long, long, long *, long *);
+extern bool xomp_native_loop_ordered_runtime_start (long, long, long, long *, long *);
+
+extern bool xomp_native_loop_static_next (long *, long *);
+extern bool xomp_native_loop_dynamic_next (long *, long *);
+extern bool xomp_native_loop_guided_next (long *, long *);
+extern bool xomp_native_loop_runtime_next (long *, long *);
+
+extern bool xomp_native_loop_ordered_static_next (long *, long *);
+extern bool xomp_native_loop_ordered_dynamic_next (long *, long *);
+extern bool xomp_native_loop_ordered_guided_next (long *, long *);
+extern bool xomp_native_loop_ordered_runtime_next (long *, long *);
+
+extern void xomp_native_loop_end (void);
+extern void xomp_native_loop_end_nowait (void);
+
+extern void xomp_native_ordered_start (void);
+extern void xomp_native_ordered_end (void);
+
+// Used by xomp.c in place of the GOMP entry points
+#define GOMP_parallel_start xomp_native_parallel_start
+#define GOMP_parallel_end xomp_native_parallel_end
+#define GOMP_barrier xomp_native_barrier
+#define GOMP_critical_name_start xomp_native_critical_name_start
+#define GOMP_critical_name_end xomp_native_critical_name_end
+#define GOMP_atomic_start xomp_native_atomic_start
+#define GOMP_atomic_end xomp_native_atomic_end
+#define GOMP_task xomp_native_task
+#define GOMP_taskwait xomp_native_taskwait
+#define GOMP_sections_start xomp_native_sections_start
+#define GOMP_sections_next xomp_native_sections_next
+#define GOMP_sections_end xomp_native_sections_end
+#define GOMP_sections_end_nowait xomp_native_sections_end_nowait
+#define GOMP_single_start xomp_native_single_start
+#define GOMP_loop_static_start xomp_native_loop_static_start
+#define GOMP_loop_dynamic_start xomp_native_loop_dynamic_start
+#define GOMP_loop_guided_start xomp_native_loop_guided_start
+#define GOMP_loop_runtime_start xomp_native_loop_runtime_start
+#define GOMP_loop_ordered_static_start xomp_native_loop_ordered_static_start
+#define GOMP_loop_ordered_dynamic_start xomp_native_loop_ordered_dynamic_start
+#define GOMP_loop_ordered_guided_start xomp_native_loop_ordered_guided_start
+#define GOMP_loop_ordered_runtime_start xomp_native_loop_ordered_runtime_start
+#define GOMP_loop_static_next xomp_native_loop_static_next
+#define GOMP_loop_dynamic_next xomp_native_loop_dynamic_next
+#define GOMP_loop_guided_next xomp_native_loop_guided_next
+#define GOMP_loop_runtime_next xomp_native_loop_runtime_next
+#define GOMP_loop_ordered_static_next xomp_native_loop_ordered_static_next
+#define GOMP_loop_ordered_dynamic_next xomp_native_loop_ordered_dynamic_next
+#define GOMP_loop_ordered_guided_next xomp_native_loop_ordered_guided_next
+#define GOMP_loop_ordered_runtime_next xomp_native_loop_ordered_runtime_next
+#define GOMP_loop_end xomp_native_loop_end
+#define GOMP_loop_end_nowait xomp_native_loop_end_nowait
+#define GOMP_ordered_start xomp_native_ordered_start
+#define GOMP_ordered_end xomp_native_ordered_end
+
+#ifdef __cplusplus
+ }
+#endif
+
+#endif /* XOMP_NATIVE_H */
@@ -0,0 +1,94 @@
+/*!
+ *  \file outlineLoopNests.cc
+ *
+ *  \brief Outlines every outermost loop nest of the input files and
+ *  reports the time spent outlining.
+ *
+ *  By default the loop nests are outlined with the batch interface,
+ *  Outliner::outline (const std::vector<SgStatement*>&). With the option
+ *  "-rose:outline:one_at_a_time" they are outlined by one call of
+ *  Outliner::outline (SgStatement*) each, as before the batch interface
+ *  existed. The makefile runs both modes on the test specimens and
+ *  compares the unparsed outputs, which must be the same.
+ *
+ *  The other -rose:outline: options (e.g. -rose:outline:temp_variable)
+ *  are accepted as by Outliner::commandLineProcessing().
+ */
+#include <rose.h>
+#include <Sawyer/Stopwatch.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <commandline_processing.h>
+#include "Outliner.hh"
+
+using namespace std;
+
+// =====================================================================
+
+//! Collects the outlineable for-loops of the input files that are not inside another loop.
+static void
+collectLoopNests (SgProject* proj, vector<SgStatement *>& loops)
+{
+  SgFilePtrList& files = proj->get_fileList ();
+  for (SgFilePtrList::iterator f = files.begin (); f != files.end (); ++f)
+    {
+      SgSourceFile* file = isSgSourceFile (*f);
+      if (!file)
+        continue;
+      vector<SgForStatement *> candidates = SageInterface::querySubTree<SgForStatement> (file, V_SgForStatement);
+      for (size_t i = 0; i < candidates.size (); ++i)
+        {
+          SgForStatement* loop = candidates[i];
+          if (loop->get_file_info ()->get_filenameString () != file->getFileName ())
+            continue; // from a header
+          if (SageInterface::getEnclosingNode<SgForStatement> (loop) != NULL)
+            continue; // inside another loop nest
+          if (Outliner::isOutlineable (loop))
+            loops.push_back (loop);
+        }
+    }
+}
+
+// =====================================================================
+
+int
+main (int argc, char* argv[])
+{
+  vector<string> argvList (argv, argv + argc);
+  bool one_at_a_time = CommandlineProcessing::isOption (argvList, "-rose:outline:", "one_at_a_time", true);
+  Outliner::commandLineProcessing (argvList);
+
+  SgProject* proj = frontend (argvList);
+  ROSE_ASSERT (proj);
+
+  vector<SgStatement *> loops;
+  collectLoopNests (proj, loops);
+
+  Sawyer::Stopwatch timer;
+  size_t count = 0;
+  if (one_at_a_time)
+    {
+      for (size_t i = 0; i < loops.size (); ++i)
+        if (Outliner::outline (loops[i]).isValid ())
+          ++count;
+    }
+  else
+    {
+      vector<Outliner::Result> results = Outliner::outline (loops);
+      for (size_t i = 0; i < results.size (); ++i)
+        if (results[i].isValid ())
+          ++count;
+    }
+  timer.stop ();
+
+  cout << "Outlined " << count << " of " << loops.size () << " loop nests "
+       << (one_at_a_time ? "one at a time" : "in one batch")
+       << " in " << timer.report () << " seconds" << endl;
+
+  AstTests::runAllTests (proj);
+  return backend (proj);
+}
+
+// eof
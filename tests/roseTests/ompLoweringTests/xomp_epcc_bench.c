@@ -0,0 +1,249 @@
+/*
+ * Overhead microbenchmarks of the XOMP runtime, in the style of the EPCC OpenMP
+ * microbenchmarks (syncbench, schedbench, taskbench).
+ *
+ * Each test runs a construct around a fixed delay loop many times and reports the
+ * overhead per construct: the test time minus the time of the same delays run
+ * sequentially. Build it once against each runtime that libxomp can use (configure
+ * with --with-gomp_omp_runtime_library=PATH, or with --enable-native-xomp) and
+ * compare the reports.
+ *
+ * Usage: xomp_epcc_bench [outer repetitions]     (threads: OMP_NUM_THREADS)
+ */
+#include "libxomp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+extern int omp_get_num_threads (void);
+extern int omp_get_thread_num (void);
+
+#define DELAY_LENGTH 100    /* iterations of the delay loop */
+#define INNER_REPS 1000     /* constructs per timed repetition */
+#define ITERS_PER_THREAD 128 /* loop iterations per thread in the scheduling tests */
+#define CHUNK_SIZE 1
+
+static int outer_reps = 20;
+static int nthreads = 1;
+static volatile double sink = 0.0;
+static void *critical_lock = NULL;
+
+static void delay (int length)
+{
+  int i;
+  volatile double a = 0.0;
+  for (i = 0; i < length; i++)
+    a += i;
+  if (a < 0)
+    sink = a;
+}
+
+// Minimum over the outer repetitions of a function's time, in microseconds per construct
+static double time_test (void (*test) (void))
+{
+  int k;
+  double best = 1.0e30;
+  for (k = 0; k < outer_reps; k++)
+  {
+    double start = xomp_time_stamp ();
+    test ();
+    double t = (xomp_time_stamp () - start) * 1.0e6 / INNER_REPS;
+    if (t < best)
+      best = t;
+  }
+  return best;
+}
+
+//---------------------------------------------
+// The tests
+static void reference_body (void)
+{
+  int j;
+  for (j = 0; j < INNER_REPS; j++)
+    delay (DELAY_LENGTH);
+}
+
+static void parallel_region (void *data)
+{
+  delay (DELAY_LENGTH);
+}
+
+static void test_parallel (void)
+{
+  int j;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    XOMP_parallel_start (parallel_region, NULL, 1, 0, __FILE__, __LINE__);
+    XOMP_parallel_end (__FILE__, __LINE__);
+  }
+}
+
+static void barrier_region (void *data)
+{
+  int j;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    delay (DELAY_LENGTH);
+    XOMP_barrier ();
+  }
+}
+
+static void single_region (void *data)
+{
+  int j;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    if (XOMP_single ())
+      delay (DELAY_LENGTH);
+    XOMP_barrier ();
+  }
+}
+
+static void critical_region (void *data)
+{
+  int j;
+  for (j = 0; j < INNER_REPS / nthreads; j++)
+  {
+    XOMP_critical_start (&critical_lock);
+    delay (DELAY_LENGTH);
+    XOMP_critical_end (&critical_lock);
+  }
+}
+
+static void for_region (void *data)
+{
+  int j;
+  long lower, upper, i;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    XOMP_loop_default (0, nthreads - 1, 1, &lower, &upper);
+    for (i = lower; i <= upper; i++)
+      delay (DELAY_LENGTH);
+    XOMP_barrier ();
+  }
+}
+
+static void dynamic_region (void *data)
+{
+  int j;
+  long lower, upper, i;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    if (XOMP_loop_dynamic_start (0, ITERS_PER_THREAD * nthreads - 1, 1, CHUNK_SIZE, &lower, &upper))
+    {
+      do
+      {
+        for (i = lower; i <= upper; i++)
+          delay (DELAY_LENGTH);
+      } while (XOMP_loop_dynamic_next (&lower, &upper));
+    }
+    XOMP_loop_end ();
+  }
+}
+
+static void guided_region (void *data)
+{
+  int j;
+  long lower, upper, i;
+  for (j = 0; j < INNER_REPS; j++)
+  {
+    if (XOMP_loop_guided_start (0, ITERS_PER_THREAD * nthreads - 1, 1, CHUNK_SIZE, &lower, &upper))
+    {
+      do
+      {
+        for (i = lower; i <= upper; i++)
+          delay (DELAY_LENGTH);
+      } while (XOMP_loop_guided_next (&lower, &upper));
+    }
+    XOMP_loop_end ();
+  }
+}
+
+static void task_body (void *data)
+{
+  delay (DELAY_LENGTH);
+}
+
+// Each thread creates its share of the tasks
+static void task_region (void *data)
+{
+  int j;
+  for (j = 0; j < INNER_REPS / nthreads; j++)
+    XOMP_task (task_body, NULL, NULL, 0, 1, 1, 0);
+  XOMP_barrier ();
+}
+
+// One thread creates all the tasks, the others execute them
+static void master_task_region (void *data)
+{
+  int j;
+  if (XOMP_single ())
+  {
+    for (j = 0; j < INNER_REPS; j++)
+      XOMP_task (task_body, NULL, NULL, 0, 1, 1, 0);
+    XOMP_taskwait ();
+  }
+  XOMP_barrier ();
+}
+
+#define DEFINE_REGION_TEST(name) \
+static void test_##name (void) \
+{ \
+  XOMP_parallel_start (name##_region, NULL, 1, 0, __FILE__, __LINE__); \
+  XOMP_parallel_end (__FILE__, __LINE__); \
+}
+
+DEFINE_REGION_TEST (barrier)
+DEFINE_REGION_TEST (single)
+DEFINE_REGION_TEST (critical)
+DEFINE_REGION_TEST (for)
+DEFINE_REGION_TEST (dynamic)
+DEFINE_REGION_TEST (guided)
+DEFINE_REGION_TEST (task)
+DEFINE_REGION_TEST (master_task)
+
+static void count_threads (void *data)
+{
+  if (omp_get_thread_num () == 0)
+    *(int *) data = omp_get_num_threads ();
+}
+
+//---------------------------------------------
+static void report (const char *name, void (*test) (void), double reference)
+{
+  double t = time_test (test);
+  printf ("%-14s %12.3f %12.3f\n", name, t, t - reference);
+}
+
+int main (int argc, char *argv[])
+{
+  if (argc > 1)
+    outer_reps = atoi (argv[1]);
+  if (outer_reps < 1)
+    outer_reps = 1;
+
+  XOMP_init (argc, argv);
+  XOMP_parallel_start (count_threads, &nthreads, 1, 0, __FILE__, __LINE__);
+  XOMP_parallel_end (__FILE__, __LINE__);
+
+  double reference = time_test (reference_body);
+  printf ("threads %d, delay %d, %d constructs per repetition, best of %d repetitions\n",
+          nthreads, DELAY_LENGTH, INNER_REPS, outer_reps);
+  printf ("%-14s %12s %12s\n", "construct", "time (us)", "overhead (us)");
+  printf ("%-14s %12.3f\n", "reference", reference);
+
+  report ("parallel", test_parallel, reference);
+  report ("barrier", test_barrier, reference);
+  report ("single", test_single, reference);
+  report ("critical", test_critical, reference);
+  report ("for", test_for, reference);
+  // The scheduling tests run ITERS_PER_THREAD delays per thread and construct
+  report ("dynamic,1", test_dynamic, reference * ITERS_PER_THREAD);
+  report ("guided,1", test_guided, reference * ITERS_PER_THREAD);
+  // The task tests run INNER_REPS tasks in total, spread over the threads
+  report ("parallel task", test_task, reference / nthreads);
+  report ("master task", test_master_task, reference / nthreads);
+
+  XOMP_terminate (0);
+  return 0;
+}
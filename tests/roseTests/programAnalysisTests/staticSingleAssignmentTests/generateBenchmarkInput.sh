@@ -0,0 +1,59 @@
+#!/bin/sh
+# Writes a large C translation unit to standard output for timing StaticSingleAssignment (see ssaBenchmark.C).
+# Each function has many variables, struct members and nested loops/branches, so phi placement and def propagation
+# dominate the analysis time.
+# Usage: generateBenchmarkInput.sh [NUMBER_OF_FUNCTIONS [NUMBER_OF_VARIABLES_PER_FUNCTION]]
+
+nfuncs=${1-200}
+nvars=${2-40}
+
+echo "struct Inner { int c; int d; };"
+echo "struct Outer { int a; struct Inner b; };"
+echo "int global_counter;"
+echo
+
+f=0
+while [ $f -lt $nfuncs ]; do
+    echo "int function_$f(int n, struct Outer *p)"
+    echo "{"
+    echo "    struct Outer s;"
+    echo "    int i, j;"
+    v=0
+    while [ $v -lt $nvars ]; do
+        echo "    int v$v = $v;"
+        v=$((v + 1))
+    done
+    echo "    s.a = n;"
+    echo "    s.b.c = 0;"
+    echo "    for (i = 0; i < n; i++) {"
+    v=0
+    while [ $v -lt $nvars ]; do
+        w=$(((v + 1) % nvars))
+        x=$(((v + 7) % nvars))
+        echo "        if ((i + $v) % 3 == 0) {"
+        echo "            v$v = v$w + i;"
+        echo "            s.b.c += v$v;"
+        echo "        } else if (v$x > v$v) {"
+        echo "            for (j = 0; j < v$x && j < n; j++) {"
+        echo "                v$x -= j;"
+        echo "                if (v$x < 0) break;"
+        echo "            }"
+        echo "            p->b.d = v$x;"
+        echo "        } else {"
+        echo "            while (v$w < n) { v$w += v$v + 1; global_counter++; }"
+        echo "            s.a = v$w;"
+        echo "        }"
+        v=$((v + 1))
+    done
+    echo "    }"
+    echo "    return s.a + s.b.c + p->b.d + global_counter"
+    v=0
+    while [ $v -lt $nvars ]; do
+        echo "        + v$v"
+        v=$((v + 1))
+    done
+    echo "        ;"
+    echo "}"
+    echo
+    f=$((f + 1))
+done